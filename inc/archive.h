@@ -0,0 +1,175 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: archive.h                                                          |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+#if !defined(__ARCHIVE_H__)
+  #define __ARCHIVE_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Magic number at the beginning of each archive file ("BDA")
+*/
+#define acARCHIVE_MAGIC "BDA"
+
+/*!
+Version of the archive format
+*/
+#define uiARCHIVE_VERSION (1)
+
+/*!
+File extension of archive files
+*/
+#define acARCHIVE_EXT "bda"
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Header at the beginning of an archive file. The header is followed by a table
+of "uiCount" entries of type "archiveentry_t"; the data of all regions follows
+the table.
+*/
+typedef struct _archiveheader
+{
+  /*!
+  Magic number "BDA"
+  */
+  char_t acMagic[3];
+
+  /*!
+  Version of the archive format
+  */
+  uint8_t uiVersion;
+
+  /*!
+  Number of regions in the archive
+  */
+  uint8_t uiCount;
+
+  /*!
+  Reserved for future use (0)
+  */
+  uint8_t uiReserved[3];
+} archiveheader_t;
+
+/*!
+Entry of the region table of an archive file
+*/
+typedef struct _archiveentry
+{
+  /*!
+  Datasource of the region (dumpmode_t)
+  */
+  uint8_t uiSource;
+
+  /*!
+  Reserved for future use (0)
+  */
+  uint8_t uiReserved[3];
+
+  /*!
+  Startoffset of the region in the datasource
+  */
+  uint32_t uiOffset;
+
+  /*!
+  Length of the region
+  */
+  uint32_t uiSize;
+
+  /*!
+  Position of the data of the region in the archive file
+  */
+  uint32_t uiData;
+} archiveentry_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function writes the header and the region table of an archive to an open
+file. The position of the data of each region is calculated from the sizes of
+the regions, so the data has to be written afterwards in the same order.
+@param pRegion Pointer to the list of regions
+@param uiCount Number of regions in the list
+@param pFile Pointer to the fileinfo of the open file
+@return EOK = no error
+*/
+int archiveCreate(const region_t* pRegion, uint8_t uiCount, const fileinfo_t* pFile);
+
+/*!
+This function reads the entry of a region from the table of an archive file.
+@param uiIndex Index of the region in the archive
+@param pEntry [OUT] Entry of the region
+@param pFile Pointer to the fileinfo of the open archive file
+@return EOK = no error
+*/
+int archiveSelect(uint8_t uiIndex, archiveentry_t* pEntry, fileinfo_t* pFile);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __ARCHIVE_H__ */
@@ -49,9 +49,41 @@ Max. length of a data block, that can be handelt with one operation
 #define uiMAX_STRIDE (16)
 
 /*!
-Max. length of a screen line
+Max. length of a screen line (32 bit address, 16 bytes in binary and the text
+of a user defined format)
 */
-#define uiMAX_LINE_LEN (64 + 16 + 8)
+#define uiMAX_LINE_LEN (8 + 16 * 9 + 24)
+
+/*!
+Max. length of a compiled format program (see "renderCompile()")
+*/
+#define uiMAX_PROGRAM (32)
+
+/*!
+Max. number of screen rows
+*/
+#define uiMAX_ROWS (24)
+
+/*!
+Max. number of regions, that can be dumped with one invocation
+*/
+#define uiMAX_REGIONS (48)
+
+/*!
+Size of the block, that is read from a datasource with one operation
+*/
+#define uiBLOCK_SIZE (256)
+
+/*!
+Number of additional file handles of an input file, that are parked at
+recently used positions (checkpoints)
+*/
+#define uiMAX_CHECKPOINTS (3)
+
+/*!
+Marker for an unknown position of a file handle
+*/
+#define uiPOS_UNKNOWN (UINT32_C(0xFFFFFFFF))
 
 /*============================================================================*/
 /*                               Namespaces                                   */
@@ -80,7 +112,8 @@ typedef enum _action
   ACTION_NONE = 0,
   ACTION_HELP,
   ACTION_INFO,
-  ACTION_DUMP
+  ACTION_DUMP,
+  ACTION_UNLOAD
 } action_t;
 
 /*!
@@ -91,9 +124,25 @@ typedef enum _dumpmode
   DUMP_NONE = 0,
   DUMP_LOGICAL,
   DUMP_PHYSICAL,
-  DUMP_FILE
+  DUMP_FILE,
+  DUMP_NEXTREG,
+  DUMP_PALETTE,
+  DUMP_TILEMAP,
+  DUMP_DISK
 } dumpmode_t;
 
+/*!
+Additional file handle, that is parked at a known position of the file. On
+FAT a seek walks the cluster chain from the beginning of the file (backward)
+or from the current position (forward), so a handle near the target saves
+walking the whole chain.
+*/
+typedef struct _checkpoint
+{
+  uint8_t hFile;
+  uint32_t uiPos;
+} checkpoint_t;
+
 /*!
 File information of the input file
 */
@@ -101,8 +150,166 @@ typedef struct _fileinfo
 {
   char_t acPathName[ESX_PATHNAME_MAX];
   uint8_t hFile;
+
+  /*!
+  Current position of "hFile" (uiPOS_UNKNOWN, if not known)
+  */
+  uint32_t uiPos;
+
+  /*!
+  Handle to write modifications back to the file (opened on the first write)
+  */
+  uint8_t hWrite;
+
+  /*!
+  Checkpoints of the input file
+  */
+  checkpoint_t tCheck[uiMAX_CHECKPOINTS];
+
+  /*!
+  Distance between the dump address and the position in the file (used to
+  read a region from an archive file)
+  */
+  uint32_t uiBase;
+
+  /*!
+  Device of a raw disk datasource (esxDOS device number)
+  */
+  uint8_t uiDevice;
+
+  /*!
+  The input file is compressed and is decoded while reading
+  */
+  bool bPacked;
 } fileinfo_t;
 
+/*!
+Description of a region to dump
+*/
+typedef struct _region
+{
+  /*!
+  Datasource of the region
+  */
+  dumpmode_t eMode;
+
+  /*!
+  Startoffset of the region
+  */
+  uint32_t uiOffset;
+
+  /*!
+  Length of the region
+  */
+  uint32_t uiSize;
+} region_t;
+
+struct _source;
+
+/*!
+Interface of a datasource. Each datasource (logical memory, physical memory,
+file, ...) implements these functions.
+*/
+typedef struct _srcops
+{
+  /*!
+  Prepare the datasource for reading
+  */
+  int (*pfnOpen)(struct _source* pSource);
+
+  /*!
+  Read a block of data from the datasource
+  */
+  int (*pfnRead)(struct _source* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+  /*!
+  Query the size of the datasource
+  */
+  uint32_t (*pfnSize)(struct _source* pSource);
+
+  /*!
+  Release the datasource
+  */
+  void (*pfnClose)(struct _source* pSource);
+
+  /*!
+  Optional: Start reading a block of data in the background (DMA); the data is
+  valid after "sourceWait()"
+  */
+  int (*pfnFetch)(struct _source* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+  /*!
+  Optional: Write a block of data to the datasource (edit mode)
+  */
+  int (*pfnWrite)(struct _source* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen);
+} srcops_t;
+
+/*!
+Instance of an open datasource with the last block read from it
+*/
+typedef struct _source
+{
+  /*!
+  Implementation of the datasource
+  */
+  const srcops_t* pOps;
+
+  /*!
+  Type of the datasource
+  */
+  dumpmode_t eMode;
+
+  /*!
+  Input file (file based datasources only)
+  */
+  fileinfo_t* pFile;
+
+  /*!
+  Address of the first byte in the block buffer
+  */
+  uint32_t uiBlockAddr;
+
+  /*!
+  Number of valid bytes in the block buffer
+  */
+  uint16_t uiBlockLen;
+
+  /*!
+  Block buffer (one of "uiBuffer")
+  */
+  uint8_t* pBlock;
+
+  /*!
+  Buffer of the block read in the background (the other one of "uiBuffer")
+  */
+  uint8_t* pFetch;
+
+  /*!
+  Address of the first byte in the fetch buffer
+  */
+  uint32_t uiFetchAddr;
+
+  /*!
+  Number of bytes in the fetch buffer
+  */
+  uint16_t uiFetchLen;
+
+  /*!
+  The fetch buffer is filled (or is being filled) in the background
+  */
+  bool bFetch;
+
+  /*!
+  The running fetch depends on the page mapped into MMU6
+  */
+  bool bFetchMmu;
+
+  /*!
+  Storage of the block buffer and the fetch buffer
+  */
+  uint8_t uiBuffer[2][uiBLOCK_SIZE];
+} source_t;
+
 /*!
 Information of the current text-screen-settings  
 */
@@ -120,6 +327,37 @@ typedef struct _renderbuffer
 {
   char_t acData[uiMAX_LINE_LEN];
   uint8_t uiLen;
+
+  /*!
+  Address format: "0" = 24 bit, "1" = 32 bit (selected by "renderSetup()")
+  */
+  uint8_t uiAddrFmt;
+
+  /*!
+  User defined format (option -e); 0 = built-in layout of the screen
+  */
+  const char_t* acFormat;
+
+  /*!
+  Format program used to render a frame (compiled once per dump by
+  "renderSetup()")
+  */
+  uint8_t uiProgram[uiMAX_PROGRAM];
+
+  /*!
+  Column of the hex representation of the first byte (uiNO_COLUMN = none)
+  */
+  uint8_t uiHexCol;
+
+  /*!
+  Number of bytes per group of the hex representation (0 = no groups)
+  */
+  uint8_t uiHexGroup;
+
+  /*!
+  Column of the ASCII representation of the first byte (uiNO_COLUMN = none)
+  */
+  uint8_t uiCharCol;
 } renderbuffer_t;
 
 /*!
@@ -163,6 +401,72 @@ typedef struct _readbuffer
   uint8_t uiData[uiMAX_STRIDE];
 } readbuffer_t;
 
+/*!
+State of the watch mode: the visible window is read again periodically and
+compared with the last sample; only changed bytes are redrawn.
+*/
+typedef struct _watchstate
+{
+  /*!
+  Number of frames (1/50 s) between two samples ("0" = watch mode off)
+  */
+  uint8_t uiFrames;
+
+  /*!
+  Frames left until the next sample
+  */
+  uint8_t uiTick;
+
+  /*!
+  Last sample of the visible window (one line per row)
+  */
+  uint8_t uiData[uiMAX_ROWS][uiMAX_STRIDE];
+
+  /*!
+  Bytes, that are highlighted as changed (one bit per byte of a row)
+  */
+  uint16_t uiMarked[uiMAX_ROWS];
+} watchstate_t;
+
+/*!
+State of the byte cursor of the interactive mode and of the decode panel, that
+shows the value of the bytes under the cursor.
+*/
+typedef struct _cursorstate
+{
+  /*!
+  Index of the byte under the cursor in the visible window (row * stride +
+  column)
+  */
+  uint16_t uiIdx;
+
+  /*!
+  Column of the decode panel ("0" = the layout leaves no room for the panel)
+  */
+  uint8_t uiPanelCol;
+
+  /*!
+  If this flag is set, the bytes under the cursor have changed (watch mode) and
+  the values of the panel have to be decoded again
+  */
+  bool bDirty;
+
+  /*!
+  Edit mode: hex digits modify the byte under the cursor
+  */
+  bool bEdit;
+
+  /*!
+  Edit mode: the high nibble of the byte under the cursor has been entered
+  */
+  bool bNibble;
+
+  /*!
+  Addresses of the first and the last byte of the selection (in any order)
+  */
+  uint32_t uiMark[2];
+} cursorstate_t;
+
 /*!
 In dieser Struktur werden alle globalen Daten der Anwendung gespeichert.
 */
@@ -189,11 +493,76 @@ typedef struct _appstate
   */
   bool bHex;
 
+  /*!
+  If this flag is set, repeated lines are shown as one line "*" (screen and hex
+  file)
+  */
+  bool bSqueeze;
+
   /*!
   If this flag is set, existing output files are overwritten
   */
   bool bForce;
 
+  /*!
+  If this flag is set, all regions are saved to one archive file.
+  */
+  bool bArchive;
+
+  /*!
+  If this flag is set, the input file is an archive and the region with index
+  "uiIndex" is read from it.
+  */
+  bool bIndex;
+
+  /*!
+  Index of the region to read from an archive file
+  */
+  uint8_t uiIndex;
+
+  /*!
+  If this flag is set, the input file is a snapshot (NEX, SNA, Z80) and the
+  offset is relative to the bank "uiBank".
+  */
+  bool bBank;
+
+  /*!
+  Bank to read from a snapshot file
+  */
+  uint8_t uiBank;
+
+  /*!
+  If this flag is set, the offset is relative to the block "uiBlock" of a tape
+  image (TAP, TZX).
+  */
+  bool bBlock;
+
+  /*!
+  Block to read from a tape image
+  */
+  uint8_t uiBlock;
+
+  /*!
+  The input file is a tape image and the index of it's blocks is available
+  */
+  bool bTape;
+
+  /*!
+  Number of frames between two samples of the change-log ("0" = no change-log)
+  */
+  uint8_t uiLog;
+
+  /*!
+  If this flag is set, all regions are captured to RAM banks first. They are
+  saved afterwards to the output file or kept for option -u.
+  */
+  bool bCapture;
+
+  /*!
+  First bank of the capture to save (option -u)
+  */
+  uint8_t uiCapture;
+
   /*!
   Datasource: Logical memory, physical memory, file
   */
@@ -209,16 +578,47 @@ typedef struct _appstate
   */
   uint32_t uiSize;
 
+  /*!
+  Number of regions in the list of regions
+  */
+  uint8_t uiRegions;
+
+  /*!
+  List of all regions to dump (sorted by datasource and address before dumping)
+  */
+  region_t tRegion[uiMAX_REGIONS];
+
   /*!
   File information of the input file
   */
   fileinfo_t tRdFile;
 
+  /*!
+  Datasource of the current region
+  */
+  source_t tSource;
+
   /*!
   File information of the output file
   */
   fileinfo_t tWrFile;
 
+  /*!
+  If this flag is set, the output argument is a directory and each region is
+  saved to a new file in it.
+  */
+  bool bOutDir;
+
+  /*!
+  Pathname of the output directory
+  */
+  char_t acOutDir[ESX_PATHNAME_MAX];
+
+  /*!
+  Next index to try when searching an unused filename in the output directory
+  */
+  uint16_t uiOutIdx;
+
   /*!
   Backup: Current speed of Z80N
   */
@@ -239,6 +639,16 @@ typedef struct _appstate
   */
   renderbuffer_t tRender;
 
+  /*!
+  State of the watch mode (interactive mode only)
+  */
+  watchstate_t tWatch;
+
+  /*!
+  Byte cursor and decode panel (interactive mode only)
+  */
+  cursorstate_t tCursor;
+
   /*!
   Exitcode of the application, that is handovered to BASIC
   */
@@ -265,6 +675,22 @@ This function render a raw byte to a hexadecimal representation
 */
 int byte2hex(uint8_t uiByte, char_t* acHex);
 
+/*!
+This function render a 32 bit value to a hexadecimal representation
+@param uiValue [IN] Value to render
+@param acHex [OUT] Hexadecimal representation (8 digits)
+@return EOK = no error
+*/
+int long2hex(uint32_t uiValue, char_t* acHex);
+
+/*!
+This function checks the extension of a pathname (case insensitive)
+@param acPathName Pathname to check
+@param acExt Extension incl. dot (".tap")
+@return "true" - pathname has the extension
+*/
+bool hasExtension(const char_t* acPathName, const char_t* acExt);
+
 /*!
 This function checks if a given value is between the limits of a given interval
 (uiMin <= uiVal <= uiMax).
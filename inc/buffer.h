@@ -0,0 +1,175 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: buffer.h                                                           |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+#if !defined(__BUFFER_H__)
+  #define __BUFFER_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of a buffer (one 8K bank of NextOS)
+*/
+#define uiBUFFER_SIZE (0x2000)
+
+/*!
+Logical address of the MMU slot used to map the banks (MMU6)
+*/
+#define uiBUFFER_ADDR (0xC000)
+
+/*!
+Max. number of banks, that are managed at the same time
+*/
+#define uiBUFFER_PAGES (80)
+
+/*!
+Marker for a bank, that is not allocated
+*/
+#define uiBUFFER_NONE (0xFF)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Buffers of the stages of the application, that are allocated at startup
+*/
+typedef enum _bufid
+{
+  BUFFER_READ = 0, /* window of the input file */
+  BUFFER_WRITE,    /* data to write to the output file */
+  BUFFER_CACHE,    /* sectors of a disk */
+  BUFFER_COUNT
+} bufid_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function allocates the banks of all stage buffers from NextOS. Missing
+banks are not an error; the stages fall back to their small static buffers.
+@return EOK = all buffers available; ENOMEM = not all buffers available
+*/
+int bufferInit(void);
+
+/*!
+This function releases all banks, that are managed by the buffer manager (the
+stage buffers and all banks allocated by "bufferAlloc()").
+*/
+void bufferFree(void);
+
+/*!
+This function checks, if a stage buffer is available
+@param eBuffer Buffer to check
+@return "true" = buffer available
+*/
+bool bufferAvailable(bufid_t eBuffer);
+
+/*!
+This function maps a stage buffer into MMU6. The buffer stays mapped until
+"bufferUnmap()" is called; only one buffer can be mapped at the same time.
+@param eBuffer Buffer to map
+@return Pointer to the buffer (0 = buffer not available)
+*/
+uint8_t* bufferMap(bufid_t eBuffer);
+
+/*!
+This function maps any bank (e.g. a bank allocated by "bufferAlloc()") into
+MMU6. Like a stage buffer, the bank stays mapped until "bufferUnmap()" is
+called; mapping another bank before does not change the page restored then.
+@param uiPage Number of the bank
+@return Pointer to the bank
+*/
+uint8_t* bufferMapPage(uint8_t uiPage);
+
+/*!
+This function restores the original page of MMU6
+*/
+void bufferUnmap(void);
+
+/*!
+This function allocates an additional bank from NextOS. The bank is released
+by "bufferRelease()" or at the latest by "bufferFree()".
+@return Number of the bank (uiBUFFER_NONE = no free bank)
+*/
+uint8_t bufferAlloc(void);
+
+/*!
+This function releases a bank allocated by "bufferAlloc()" (or a bank kept by
+a previous invocation)
+@param uiPage Number of the bank
+*/
+void bufferRelease(uint8_t uiPage);
+
+/*!
+This function removes a bank from the buffer manager; the bank stays
+allocated after the application has finished.
+@param uiPage Number of the bank
+*/
+void bufferKeep(uint8_t uiPage);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __BUFFER_H__ */
@@ -0,0 +1,201 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: capture.h                                                          |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+#if !defined(__CAPTURE_H__)
+  #define __CAPTURE_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Magic number at the beginning of a capture in RAM ("BDM")
+*/
+#define acCAPTURE_MAGIC "BDM"
+
+/*!
+Version of the capture format
+*/
+#define uiCAPTURE_VERSION (1)
+
+/*!
+Max. number of 8K banks of a capture (incl. the header)
+*/
+#define uiCAPTURE_PAGES (64)
+
+/*!
+Number of 8K banks of the memory (2MB), the first bank of a capture is one of them
+*/
+#define uiCAPTURE_BANKS (224)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Header of a capture in RAM. The header is saved at the beginning of the first
+bank; the data of all regions follows the header without gaps across all
+banks of the capture. The number of the first bank identifies the capture.
+*/
+typedef struct _captureheader
+{
+  /*!
+  Magic number "BDM"
+  */
+  char_t acMagic[3];
+
+  /*!
+  Version of the capture format
+  */
+  uint8_t uiVersion;
+
+  /*!
+  Number of banks of the capture
+  */
+  uint8_t uiPages;
+
+  /*!
+  Number of captured regions
+  */
+  uint8_t uiRegions;
+
+  /*!
+  The capture is saved as archive file
+  */
+  bool bArchive;
+
+  /*!
+  Reserved for future use (0)
+  */
+  uint8_t uiReserved;
+
+  /*!
+  Number of bytes of all regions
+  */
+  uint32_t uiSize;
+
+  /*!
+  Banks of the capture
+  */
+  uint8_t uiPage[uiCAPTURE_PAGES];
+
+  /*!
+  Captured regions
+  */
+  region_t tRegion[uiMAX_REGIONS];
+} captureheader_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function starts a capture: the banks for all regions are allocated from
+NextOS and the header is saved in the first bank.
+@param pRegion Pointer to the list of regions
+@param uiCount Number of regions in the list
+@param bArchive "true" = the capture is saved as archive file
+@return EOK = no error; EFBIG = regions too large; ENOMEM = no free bank
+*/
+int captureOpen(const region_t* pRegion, uint8_t uiCount, bool bArchive);
+
+/*!
+This function copies the next region of the capture from it's datasource to
+the banks (regions are copied in the order of the list).
+@param pSource Pointer to the open datasource of the region
+@param pRegion Pointer to the region
+@return EOK = no error
+*/
+int captureRegion(source_t* pSource, const region_t* pRegion);
+
+/*!
+This function attaches to a capture of a previous invocation.
+@param uiBank Number of the first bank of the capture
+@return EOK = no error; ENOTSUP = bank contains no capture
+*/
+int captureAttach(uint8_t uiBank);
+
+/*!
+This function returns the header of the current capture
+@return Pointer to the header
+*/
+const captureheader_t* captureInfo(void);
+
+/*!
+This function writes the current capture to an open file. Each bank is written
+with one operation; archives get a region table in front of the data.
+@param pFile Pointer to the fileinfo of the open output file
+@return EOK = no error
+*/
+int captureFlush(const fileinfo_t* pFile);
+
+/*!
+This function finishes the current capture.
+@param bKeep "true" = the banks stay allocated for a later flush;
+             "false" = the banks are released
+*/
+void captureClose(bool bKeep);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __CAPTURE_H__ */
@@ -0,0 +1,193 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: changelog.h                                                        |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+#if !defined(__CHANGELOG_H__)
+  #define __CHANGELOG_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Magic number at the beginning of each change-log file ("BDL")
+*/
+#define acLOG_MAGIC "BDL"
+
+/*!
+Version of the change-log format
+*/
+#define uiLOG_VERSION (1)
+
+/*!
+File extension of change-log files
+*/
+#define acLOG_EXT "bdl"
+
+/*!
+Max. size of a region, that can be sampled (size of the last sample, that is
+kept in 8K banks of NextOS)
+*/
+#define uiLOG_MAX_SIZE (UINT32_C(0x8000))
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Header at the beginning of a change-log file. The header is followed by the
+records of all changes; the first sample is saved completely.
+*/
+typedef struct _logheader
+{
+  /*!
+  Magic number "BDL"
+  */
+  char_t acMagic[3];
+
+  /*!
+  Version of the change-log format
+  */
+  uint8_t uiVersion;
+
+  /*!
+  Datasource of the region (dumpmode_t)
+  */
+  uint8_t uiSource;
+
+  /*!
+  Number of frames between two samples
+  */
+  uint8_t uiFrames;
+
+  /*!
+  Reserved for future use (0)
+  */
+  uint8_t uiReserved[2];
+
+  /*!
+  Startoffset of the region in the datasource
+  */
+  uint32_t uiOffset;
+
+  /*!
+  Length of the region
+  */
+  uint32_t uiSize;
+} logheader_t;
+
+/*!
+Header of a change; it is followed by "uiLen" bytes of the new data
+*/
+typedef struct _logrecord
+{
+  /*!
+  Frame counter (FRAMES) at the time of the sample
+  */
+  uint32_t uiFrame;
+
+  /*!
+  Address of the first changed byte in the datasource
+  */
+  uint32_t uiAddr;
+
+  /*!
+  Number of changed bytes
+  */
+  uint16_t uiLen;
+} logrecord_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function starts a change-log: the banks for the last sample are allocated
+and the header is written to the open output file.
+@param pRegion Pointer to the region to sample
+@param uiFrames Number of frames between two samples
+@param pFile Pointer to the fileinfo of the open output file
+@return EOK = no error; ERANGE = region too large; ENOMEM = no free bank
+*/
+int logOpen(const region_t* pRegion, uint8_t uiFrames, const fileinfo_t* pFile);
+
+/*!
+This function samples the region once. Each block of the region is compared
+with the last sample; the range from the first to the last changed byte of
+the block is appended to the change-log.
+@param pSource Pointer to the open datasource of the region
+@param pFile Pointer to the fileinfo of the open output file
+@return EOK = no error
+*/
+int logSample(source_t* pSource, const fileinfo_t* pFile);
+
+/*!
+This function finishes a change-log: the write buffer is flushed and the
+banks are released.
+@param pFile Pointer to the fileinfo of the open output file
+@return EOK = no error
+*/
+int logClose(const fileinfo_t* pFile);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __CHANGELOG_H__ */
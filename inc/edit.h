@@ -0,0 +1,150 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: edit.h                                                             |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+#if !defined(__EDIT_H__)
+  #define __EDIT_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of a block of the edit overlay (aligned to it's size)
+*/
+#define uiEDIT_BLOCK_SIZE (0x100)
+
+/*!
+Max. number of dirty blocks (data and mask of all blocks fit into one 8K bank)
+*/
+#define uiEDIT_BLOCKS (28)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function prepares the edit overlay: the bank for the dirty blocks is
+allocated from NextOS (only once).
+@return EOK = no error; ENOMEM = no free bank
+*/
+int editOpen(void);
+
+/*!
+This function discards all modifications and releases the bank of the edit
+overlay.
+*/
+void editClose(void);
+
+/*!
+This function modifies a byte in the edit overlay; the datasource itself is
+not changed before "editSave()".
+@param uiAddr Address of the byte
+@param uiValue New value of the byte
+@return EOK = no error; ENOMEM = too many dirty blocks
+*/
+int editPoke(uint32_t uiAddr, uint8_t uiValue);
+
+/*!
+This function replaces the bytes of a frame, that are modified in the edit
+overlay.
+@param pRead Pointer to the read buffer (frame read from the datasource)
+*/
+void editApply(readbuffer_t* pRead);
+
+/*!
+This function replaces the bytes of a block of data, that are modified in the
+edit overlay (used to export the modified data).
+@param uiAddr Address of the first byte of the data
+@param pData Pointer to the data read from the datasource
+@param uiLen Number of bytes of the data
+*/
+void editPatch(uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+This function returns the number of dirty blocks of the edit overlay.
+@return Number of dirty blocks
+*/
+uint8_t editCount(void);
+
+/*!
+This function writes all dirty blocks back to the datasource. Each block is
+written with one operation (the range from the first to the last modified
+byte); the block is clean afterwards.
+@param pSource Pointer to the datasource
+@return EOK = no error
+*/
+int editSave(source_t* pSource);
+
+/*!
+This function discards all modifications of the edit overlay.
+*/
+void editDiscard(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __EDIT_H__ */
@@ -86,13 +86,100 @@ typedef struct _rdr_state
 /*                               Prototypen                                   */
 /*============================================================================*/
 /*!
-This function reads one data frame (block) from the data source
-@param eMode Operationmode (logical, physical, file)
-@param pFile Optional: Pointer to file to read from
+This function opens the input file and all of it's checkpoints
+@param pFile Pointer to the file to open
+@return EOK = no error
+*/
+int openFile(fileinfo_t* pFile);
+
+/*!
+This function closes the input file and all of it's checkpoints
+@param pFile Pointer to the file to close
+*/
+void closeFile(fileinfo_t* pFile);
+
+/*!
+This function opens a datasource
+@param pSource Pointer to the datasource
+@param eMode Type of the datasource (logical, physical, file)
+@param pFile Optional: Pointer to the (open) input file
+@return EOK = no error
+*/
+int sourceOpen(source_t* pSource, dumpmode_t eMode, fileinfo_t* pFile);
+
+/*!
+This function returns the size of a datasource
+@param pSource Pointer to the datasource
+@return Size of the datasource in bytes
+*/
+uint32_t sourceSize(source_t* pSource);
+
+/*!
+This function closes a datasource
+@param pSource Pointer to the datasource
+*/
+void sourceClose(source_t* pSource);
+
+/*!
+This function discards the block buffer of a datasource, so the next frame is
+read again from the datasource (required to see changes of memory).
+@param pSource Pointer to the datasource
+*/
+void sourceFlush(source_t* pSource);
+
+/*!
+This function checks, if data can be written to a datasource (edit mode).
+@param pSource Pointer to the datasource
+@return "true" = datasource is writable
+*/
+bool sourceWritable(const source_t* pSource);
+
+/*!
+This function writes a block of data to a datasource with one operation. The
+block buffer (and the window of a file) is discarded afterwards.
+@param pSource Pointer to the datasource
+@param uiAddr Address of the first byte
+@param pData Pointer to the data
+@param uiLen Number of bytes to write
+@return EOK = no error; ENOTSUP = datasource is not writable
+*/
+int sourceWrite(source_t* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen);
+
+/*!
+This function starts reading the block following the block buffer in the
+background (DMA), so the next block is transferred while the current one is
+formatted. "readFrame()" takes the block over as soon as it is needed.
+@param pSource Pointer to the datasource
+@param pRead Pointer to the readbuffer (bounds of the region)
+@return EOK = no error; ENOTSUP = the datasource can't read in the background
+*/
+int sourcePrefetch(source_t* pSource, const readbuffer_t* pRead);
+
+/*!
+This function waits until the block read in the background is complete and
+restores the mapping of MMU6.
+@param pSource Pointer to the datasource
+*/
+void sourceWait(source_t* pSource);
+
+/*!
+This function reads a block of data from a datasource into it's block buffer
+@param pSource Pointer to the datasource
+@param uiAddr Address of the first byte to read
+@param uiLen Number of bytes to read (max. uiBLOCK_SIZE)
+@return EOK = no error
+*/
+int readBlock(source_t* pSource, uint32_t uiAddr, uint16_t uiLen);
+
+/*!
+This function reads one data frame from the datasource. The frame is taken
+from the block buffer of the datasource; only if the frame is not part of the
+buffer, the next block is read.
+@param pSource Pointer to the datasource
 @param pRead Pointer to the readbuffer
 @return EOK = no error
 */
-int readFrame(dumpmode_t eMode, fileinfo_t* pFile, readbuffer_t* pRead);
+int readFrame(source_t* pSource, readbuffer_t* pRead);
 
 /*============================================================================*/
 /*                               Klassen                                      */
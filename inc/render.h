@@ -58,6 +58,26 @@ Character used as separator between columns
 */
 #define cSEPERATOR_CHAR '|'
 
+/*!
+Addresses above this limit require a 32 bit address column
+*/
+#define uiMAX_ADDR_24 (UINT32_C(0x01000000))
+
+/*!
+Marker for a column, that is not part of the layout
+*/
+#define uiNO_COLUMN (0xFF)
+
+/*!
+Number of rows of the decode panel (label and value of each item)
+*/
+#define uiDECODE_ROWS (12)
+
+/*!
+Number of columns of the decode panel (incl. the separator)
+*/
+#define uiDECODE_COLS (12)
+
 /*============================================================================*/
 /*                               Namespaces                                   */
 /*============================================================================*/
@@ -77,10 +97,73 @@ Character used as separator between columns
 /*============================================================================*/
 /*                               Typ-Definitionen                             */
 /*============================================================================*/
+/*!
+Visual representation of a single byte of a frame and it's position on the
+screen (used to update single bytes without rendering the whole frame)
+*/
+typedef struct _cellinfo
+{
+  /*!
+  Column of the hexadecimal representation
+  */
+  uint8_t uiHexCol;
+
+  /*!
+  Column of the ASCII representation (uiNO_COLUMN, if the layout has none)
+  */
+  uint8_t uiCharCol;
+
+  /*!
+  Hexadecimal representation (zero terminated)
+  */
+  char_t acHex[3];
+
+  /*!
+  ASCII representation (zero terminated)
+  */
+  char_t acChar[2];
+} cellinfo_t;
 
 /*============================================================================*/
 /*                               Prototypen                                   */
 /*============================================================================*/
+/*!
+This function compiles a format into a format program. The format consists of
+literal characters and conversions (similar to "hexdump -e"):
+@code
+"%a"  : address of the frame (6 or 8 digits)
+"%x"  : all bytes of the frame in hex
+"%nx" : all bytes of the frame in hex, groups of n bytes (n = 1 - 9)
+"%c"  : all bytes of the frame as ASCII characters
+"%b"  : all bytes of the frame in binary
+"%o"  : all bytes of the frame in octal
+"%d"  : all bytes of the frame in decimal
+"%hx" : 16 bit words in hex, little endian ("%Hx": big endian)
+"%lx" : 32 bit words in hex, little endian ("%Lx": big endian)
+"%hd" : 16 bit words in decimal, little endian ("%Hd": big endian)
+"%ld" : 32 bit words in decimal, little endian ("%Ld": big endian)
+"%%"  : the character "%"
+@endcode
+@param acFormat Format to compile
+@param pRender Pointer to the render buffer (receives the program)
+@return EOK = no error; EINVAL = invalid conversion; ERANGE = format too long
+*/
+int renderCompile(const char_t* acFormat, renderbuffer_t* pRender);
+
+/*!
+This function selects the layout (or the user defined format) and the address
+format to render the frames of a region and compiles it. It has to be called
+once before the frames of a region are rendered.
+@param pScreen Pointer to the screen parameters
+@param pRead Pointer to the read buffer (bounds of the region)
+@param pRender Pointer to the render buffer
+@return EOK = no error; ERANGE = line too long
+*/
+int renderSetup(
+  const screeninfo_t* pScreen,
+  const readbuffer_t* pRead,
+  renderbuffer_t* pRender);
+
 /*!
 This function renders a dataframe in to a visual representation (hex dump).
 @param pScreen Pointer to the screen parameters
@@ -93,6 +176,39 @@ int renderFrame(
   const readbuffer_t* pRead,
   renderbuffer_t* pRender);
 
+/*!
+This function renders a single byte of a dataframe and calculates the columns
+of it's representation in the current layout.
+@param pRead Pointer to the read buffer
+@param pRender Pointer to the render buffer (layout and address format)
+@param uiIdx Index of the byte in the dataframe
+@param pCell Pointer to the rendered byte
+@return EOK = no error; ERANGE = byte is out of the bounds of the region
+*/
+int renderCell(
+  const readbuffer_t* pRead,
+  const renderbuffer_t* pRender,
+  uint8_t uiIdx,
+  cellinfo_t* pCell);
+
+/*!
+This function renders a row of the decode panel, that shows the value of the
+bytes under the cursor as uint16/uint32 (LE/BE), float and the address of the
+cursor. The even rows are the labels, the odd rows the values.
+@param pData Pointer to the bytes under the cursor
+@param uiLen Number of valid bytes under the cursor (0 - 4)
+@param uiAddr Address of the cursor
+@param uiRow Row of the panel (0 - uiDECODE_ROWS - 1)
+@param acText [OUT] Rendered row (uiDECODE_COLS characters + '\0')
+@return EOK = no error
+*/
+int renderDecode(
+  const uint8_t* pData,
+  uint8_t uiLen,
+  uint32_t uiAddr,
+  uint8_t uiRow,
+  char_t* acText);
+
 /*============================================================================*/
 /*                               Klassen                                      */
 /*============================================================================*/
@@ -80,6 +80,23 @@ int saveFrame(
   const renderbuffer_t* pRender,
   const fileinfo_t* pFile);
 
+/*!
+This function saves a block of raw data to a open file (via the write buffer).
+@param pData Pointer to the data
+@param uiLen Length of the data
+@param pFile Pointer to the fileinfo of the open file
+@return EOK = no error
+*/
+int saveBlock(const uint8_t* pData, uint16_t uiLen, const fileinfo_t* pFile);
+
+/*!
+This function writes the content of the write buffer to the file. It has to be
+called before the file is closed.
+@param pFile Pointer to the fileinfo of the open file
+@return EOK = no error
+*/
+int saveFlush(const fileinfo_t* pFile);
+
 /*============================================================================*/
 /*                               Klassen                                      */
 /*============================================================================*/
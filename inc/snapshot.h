@@ -0,0 +1,119 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: snapshot.h                                                         |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+#if !defined(__SNAPSHOT_H__)
+  #define __SNAPSHOT_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Max. number of 16K banks in a snapshot (NEX: 0 - 111)
+*/
+#define uiSNAP_BANKS (112)
+
+/*!
+Size of a 16K bank
+*/
+#define uiSNAP_BANK_SIZE (UINT32_C(0x4000))
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+This enumeration lists all supported snapshot formats
+*/
+typedef enum _snaptype
+{
+  SNAP_NONE = 0,
+  SNAP_SNA,
+  SNAP_Z80,
+  SNAP_NEX
+} snaptype_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function detects the format of a snapshot file (NEX, SNA, Z80) and reads
+it's header once to build the index of the file positions of all banks.
+@param pFile Pointer to the fileinfo of the open snapshot file
+@return EOK = no error
+*/
+int snapshotIndex(fileinfo_t* pFile);
+
+/*!
+This function returns the position of a bank in the indexed snapshot file.
+@param uiBank Number of the 16K bank
+@param pOffset [OUT] Position of the bank in the file
+@return EOK = no error; ERANGE = bank not part of the snapshot; ENOTSUP = bank
+        is compressed
+*/
+int snapshotBank(uint8_t uiBank, uint32_t* pOffset);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __SNAPSHOT_H__ */
@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: tape.h                                                             |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+#if !defined(__TAPE_H__)
+  #define __TAPE_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Max. number of blocks in the index of a tape image
+*/
+#define uiTAPE_BLOCKS (255)
+
+/*!
+Value returned by "tapeFind()", if the offset is not part of a block
+*/
+#define uiTAPE_NONE (0xFF)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+This enumeration lists all supported tape image formats
+*/
+typedef enum _tapetype
+{
+  TAPE_NONE = 0,
+  TAPE_TAP,
+  TAPE_TZX
+} tapetype_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function detects a tape image (TAP by extension, TZX by signature) and
+walks once through it's chain of blocks to build the index of all blocks.
+@param pFile Pointer to the fileinfo of the open tape image
+@return EOK = no error; ENOTSUP = no tape image
+*/
+int tapeIndex(fileinfo_t* pFile);
+
+/*!
+This function returns the number of blocks in the index
+@return Number of blocks
+*/
+uint8_t tapeCount(void);
+
+/*!
+This function returns the position, size and type of a block of the index.
+The type of a TAP block is it's flag byte (0x00 = header, 0xFF = data), the
+type of a TZX block is it's ID.
+@param uiIndex Number of the block
+@param pOffset [OUT] Position of the block in the file
+@param pSize [OUT] Size of the block (incl. length/ID)
+@param pType [OUT] Optional: Type of the block
+@return EOK = no error
+*/
+int tapeBlock(uint8_t uiIndex, uint32_t* pOffset, uint32_t* pSize, uint8_t* pType);
+
+/*!
+This function searches the block containing a position of the file
+@param uiOffset Position in the file
+@return Number of the block; uiTAPE_NONE = not found
+*/
+uint8_t tapeFind(uint32_t uiOffset);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __TAPE_H__ */
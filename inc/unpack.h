@@ -0,0 +1,119 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: unpack.h                                                           |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+#if !defined(__UNPACK_H__)
+  #define __UNPACK_H__
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+File extension of compressed files (LZSS, 4K window)
+*/
+#define acUNPACK_EXT ".lzs"
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function checks, if the input file is compressed. A compressed file is
+decoded once to detect it's size and to save restart checkpoints (state of
+the decoder and it's window) in 8K banks of NextOS.
+@param pFile Pointer to the fileinfo of the open input file
+@return EOK = no error; ENOTSUP = file is not compressed
+*/
+int unpackOpen(fileinfo_t* pFile);
+
+/*!
+This function reads decoded data of a compressed file. Data within the window
+of the decoder is copied directly; backward jumps restart at the nearest
+checkpoint.
+@param pFile Pointer to the fileinfo of the open input file
+@param uiAddr Position of the first byte in the decoded data
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
+*/
+int unpackRead(fileinfo_t* pFile, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+This function returns the size of the decoded data
+@return Size in bytes
+*/
+uint32_t unpackSize(void);
+
+/*!
+This function releases the checkpoints (banks of NextOS)
+*/
+void unpackClose(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#endif /* __UNPACK_H__ */
@@ -77,6 +77,12 @@ Error code: Timeout in operation
   #warning "RTM_28MHZ not defined in zxn.h"
 #endif
 
+/*!
+Blocks shorter than this are copied by the CPU (LDI); the setup of the zxnDMA takes
+longer than the transfer itself.
+*/
+#define uiZXN_DMA_MIN (32)
+
 /*!
 Macro to describe a invalid file handle
 */
@@ -148,6 +154,81 @@ This function sets the colour of the border by a call of the ROM-function
 void zxn_border_fastcall(uint8_t uiColour) __z88dk_fastcall;
 #define zxn_border(x) zxn_border_fastcall(x)
 
+/*!
+This function copies a block of memory with the zxnDMA (memory to memory,
+continuous mode).
+@param pDst Destination address
+@param pSrc Source address
+@param uiLen Number of bytes to copy
+*/
+extern void zxn_dma_copy_callee(void* pDst, const void* pSrc, uint16_t uiLen) __z88dk_callee;
+#define zxn_dma_copy(d, s, n) zxn_dma_copy_callee(d, s, n)
+
+/*!
+This function starts a copy of a block of memory with the zxnDMA (burst mode
+without prescaler) and returns at once; zxn_dma_busy() tells, when the transfer
+is finished.
+@param pDst Destination address
+@param pSrc Source address
+@param uiLen Number of bytes to copy
+*/
+extern void zxn_dma_start_callee(void* pDst, const void* pSrc, uint16_t uiLen) __z88dk_callee;
+#define zxn_dma_start(d, s, n) zxn_dma_start_callee(d, s, n)
+
+/*!
+This function checks, if the transfer started by zxn_dma_start() is running.
+@return true = transfer is running; false = transfer is finished
+*/
+extern bool zxn_dma_busy(void);
+
+/*!
+This function copies a block of memory with an unrolled LDI chain.
+@param pDst Destination address
+@param pSrc Source address
+@param uiLen Number of bytes to copy
+@return Destination address
+*/
+extern void* zxn_ldi_callee(void* pDst, const void* pSrc, uint16_t uiLen) __z88dk_callee;
+#define zxn_ldi(d, s, n) zxn_ldi_callee(d, s, n)
+
+/*!
+This function compares two blocks of memory.
+@param pData1 First block
+@param pData2 Second block
+@param uiLen Number of bytes to compare
+@return Index of the first byte, that differs (uiLen = blocks are equal)
+*/
+extern uint16_t zxn_mismatch_callee(const void* pData1, const void* pData2, uint16_t uiLen) __z88dk_callee;
+#define zxn_mismatch(a, b, n) zxn_mismatch_callee(a, b, n)
+
+/*!
+This function checks, if all bytes of a block of memory have the same value.
+@param pData Block to check
+@param uiLen Number of bytes to check
+@param uiValue Expected value of all bytes
+@return true = all bytes are equal to the value
+*/
+extern bool zxn_memeq_callee(const void* pData, uint16_t uiLen, uint8_t uiValue) __z88dk_callee;
+#define zxn_memeq(p, n, v) zxn_memeq_callee(p, n, v)
+
+/*!
+This function adds a 16 bit value to a 32 bit value in memory.
+@param pValue Pointer to the 32 bit value
+@param uiAdd Value to add
+*/
+extern void zxn_add32_callee(uint32_t* pValue, uint16_t uiAdd) __z88dk_callee;
+#define zxn_add32(p, n) zxn_add32_callee(p, n)
+
+/*!
+This function copies a block of memory. Long blocks are copied by the zxnDMA,
+short blocks by the CPU (unrolled LDI).
+@param pDst Destination address
+@param pSrc Source address
+@param uiLen Number of bytes to copy
+@return Destination address
+*/
+void* zxn_memcpy(void* pDst, const void* pSrc, uint16_t uiLen);
+
 /*!
 This function detects, if Radastan mode is active or not
 (LAYER 1,0 with 16 colours).
@@ -185,6 +266,13 @@ int zxn_normalizepath(char_t* acPath);
 */
 void zxn_gotoxy(uint8_t uiX, uint8_t uiY);
 
+/*!
+This function enables or disables inverse video for the following output to
+the screen (works in all text modes, also without colour attributes).
+@param bOn "true" = inverse video on; "false" = inverse video off
+*/
+void zxn_inverse(bool bOn);
+
 /*!
 This function detects the index of the most significant bit in an value of
 type "uint8_t"
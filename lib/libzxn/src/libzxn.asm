@@ -1,6 +1,13 @@
 SECTION code_user
 PUBLIC _zxn_pixelad_callee
 PUBLIC _zxn_border_fastcall
+PUBLIC _zxn_dma_copy_callee
+PUBLIC _zxn_dma_start_callee
+PUBLIC _zxn_dma_busy
+PUBLIC _zxn_ldi_callee
+PUBLIC _zxn_mismatch_callee
+PUBLIC _zxn_memeq_callee
+PUBLIC _zxn_add32_callee
 
 ; ==============================================================================
 ; uint8_t* zxn_pixelad_callee(uint8_t x, uint8_t y) __z88dk_callee
@@ -31,3 +38,269 @@ _zxn_border_fastcall:
   ld   a, l     ; __z88dk_fastcall: erstes (einziges) Arg liegt in L
   call 0x2294   ; BORDER-Routine im 48K-ROM
   ret
+
+; ==============================================================================
+; void zxn_dma_copy_callee(void* pDst, const void* pSrc, uint16_t uiLen) __z88dk_callee
+; ------------------------------------------------------------------------------
+; copies a block of memory with the zxnDMA (port 0x6B, continuous mode; the CPU
+; is halted until the transfer is finished)
+; ==============================================================================
+_zxn_dma_copy_callee:
+  pop  hl       ; return address
+  pop  de       ; pDst
+  pop  bc       ; pSrc
+  ex   (sp),hl  ; HL = uiLen, return address back on stack
+
+  ld   a, h
+  or   l
+  ret  z        ; nothing to copy
+
+  ld   (dma_len), hl
+  ld   (dma_src), bc
+  ld   (dma_dst), de
+
+  ld   hl, dma_prog
+  ld   bc, +((dma_prog_end - dma_prog) * 256) + 0x6B
+  otir          ; upload and start the DMA program
+  ret
+
+; ==============================================================================
+; void zxn_dma_start_callee(void* pDst, const void* pSrc, uint16_t uiLen) __z88dk_callee
+; ------------------------------------------------------------------------------
+; starts a copy of a block of memory with the zxnDMA (burst mode) and returns at
+; once; the transfer runs at full speed, the CPU continues, when the DMA releases
+; the bus
+; ==============================================================================
+_zxn_dma_start_callee:
+  pop  hl       ; return address
+  pop  de       ; pDst
+  pop  bc       ; pSrc
+  ex   (sp),hl  ; HL = uiLen, return address back on stack
+
+  ld   a, h
+  or   l
+  ret  z        ; nothing to copy
+
+  ld   (dma_burst_len), hl
+  ld   (dma_burst_src), bc
+  ld   (dma_burst_dst), de
+
+  ld   hl, dma_burst
+  ld   bc, +((dma_burst_end - dma_burst) * 256) + 0x6B
+  otir          ; upload and start the DMA program
+  ret
+
+; ==============================================================================
+; bool zxn_dma_busy(void)
+; ------------------------------------------------------------------------------
+; checks, if the transfer started by zxn_dma_start() is still running
+; ==============================================================================
+_zxn_dma_busy:
+  ld   a, 0xBF  ; WR6: read status byte
+  out  (0x6B), a
+  in   a, (0x6B)
+  ld   l, 0
+  bit  5, a     ; E = 0: end of block reached
+  ret  z
+  inc  l
+  ret
+
+; ==============================================================================
+; void* zxn_ldi_callee(void* pDst, const void* pSrc, uint16_t uiLen) __z88dk_callee
+; ------------------------------------------------------------------------------
+; copies a block of memory with an unrolled chain of LDI (16 T-states per byte
+; instead of 21 for LDIR)
+; ==============================================================================
+_zxn_ldi_callee:
+  pop  hl       ; return address
+  pop  de       ; pDst
+  pop  bc       ; pSrc
+  ex   (sp),hl  ; HL = uiLen, return address back on stack
+  push de       ; result
+
+  push hl
+  ld   h, b
+  ld   l, c     ; HL = pSrc
+  pop  bc       ; BC = uiLen
+
+  ld   a, c
+  and  0x07     ; single bytes up to a multiple of 8
+  jr   z, ldi_blocks
+
+ldi_single:
+  ldi
+  dec  a
+  jr   nz, ldi_single
+
+ldi_blocks:
+  ld   a, b
+  or   c
+  jr   z, ldi_end
+
+ldi_loop:
+  ldi
+  ldi
+  ldi
+  ldi
+  ldi
+  ldi
+  ldi
+  ldi
+  jp   pe, ldi_loop
+
+ldi_end:
+  pop  hl       ; HL = pDst
+  ret
+
+; ==============================================================================
+; uint16_t zxn_mismatch_callee(const void* pData1, const void* pData2, uint16_t uiLen) __z88dk_callee
+; ------------------------------------------------------------------------------
+; compares two blocks of memory and returns the index of the first byte, that
+; differs (uiLen, if both blocks are equal)
+; ==============================================================================
+_zxn_mismatch_callee:
+  pop  hl       ; return address
+  pop  de       ; pData1
+  pop  bc       ; pData2
+  ex   (sp),hl  ; HL = uiLen, return address back on stack
+  push hl       ; uiLen
+
+  push bc
+  ld   b, h
+  ld   c, l     ; BC = uiLen
+  ex   de, hl   ; HL = pData1
+  pop  de       ; DE = pData2
+
+  ld   a, b
+  or   c
+  jr   z, mismatch_none
+
+mismatch_loop:
+  ld   a, (de)
+  inc  de
+  cpi           ; compare with (HL), HL++, BC--
+  jr   nz, mismatch_found
+  jp   pe, mismatch_loop
+
+mismatch_none:
+  pop  hl       ; HL = uiLen
+  ret
+
+mismatch_found:
+  pop  hl       ; HL = uiLen - BC - 1
+  scf
+  sbc  hl, bc
+  ret
+
+; ==============================================================================
+; bool zxn_memeq_callee(const void* pData, uint16_t uiLen, uint8_t uiValue) __z88dk_callee
+; ------------------------------------------------------------------------------
+; checks, if all bytes of a block of memory are equal to the given value
+; ==============================================================================
+_zxn_memeq_callee:
+  pop  hl       ; return address
+  pop  de       ; pData
+  pop  bc       ; BC = uiLen
+  dec  sp
+  pop  af       ; A = uiValue
+  push hl       ; return address back on stack
+  ex   de, hl   ; HL = pData
+
+  ld   e, a
+  ld   a, b
+  or   c
+  ld   a, e
+  jr   z, memeq_true
+
+memeq_loop:
+  cpi           ; compare with (HL), HL++, BC--
+  jr   nz, memeq_false
+  jp   po, memeq_true
+  cpi
+  jr   nz, memeq_false
+  jp   pe, memeq_loop
+
+memeq_true:
+  ld   l, 1
+  ret
+
+memeq_false:
+  ld   l, 0
+  ret
+
+; ==============================================================================
+; void zxn_add32_callee(uint32_t* pValue, uint16_t uiAdd) __z88dk_callee
+; ------------------------------------------------------------------------------
+; adds a 16 bit value to a 32 bit value in memory
+; ==============================================================================
+_zxn_add32_callee:
+  pop  hl       ; return address
+  pop  de       ; pValue
+  pop  bc       ; BC = uiAdd
+  push hl       ; return address back on stack
+  ex   de, hl   ; HL = pValue
+
+  ld   a, (hl)
+  add  a, c
+  ld   (hl), a
+  inc  hl
+  ld   a, (hl)
+  adc  a, b
+  ld   (hl), a
+  ret  nc       ; no carry into the upper 16 bit
+
+  inc  hl
+  inc  (hl)
+  ret  nz
+
+  inc  hl
+  inc  (hl)
+  ret
+
+SECTION data_user
+
+; ------------------------------------------------------------------------------
+; DMA program: memory (A) to memory (B), both incrementing
+; ------------------------------------------------------------------------------
+dma_prog:
+  defb 0x83     ; WR6: disable DMA
+  defb 0x7D     ; WR0: A -> B, port A address and block length follow
+dma_src:
+  defw 0
+dma_len:
+  defw 0
+  defb 0x54     ; WR1: port A is memory, increment, timing byte follows
+  defb 0x02     ;      cycle length 2
+  defb 0x50     ; WR2: port B is memory, increment, timing byte follows
+  defb 0x02     ;      cycle length 2
+  defb 0xAD     ; WR4: continuous mode, port B address follows
+dma_dst:
+  defw 0
+  defb 0x82     ; WR5: stop at end of block
+  defb 0xCF     ; WR6: load
+  defb 0x87     ; WR6: enable DMA
+dma_prog_end:
+
+; ------------------------------------------------------------------------------
+; DMA program: memory (A) to memory (B), both incrementing, burst mode
+; ------------------------------------------------------------------------------
+dma_burst:
+  defb 0x83     ; WR6: disable DMA
+  defb 0x8B     ; WR6: reinitialize status byte
+  defb 0x7D     ; WR0: A -> B, port A address and block length follow
+dma_burst_src:
+  defw 0
+dma_burst_len:
+  defw 0
+  defb 0x54     ; WR1: port A is memory, increment, timing byte follows
+  defb 0x02     ;      cycle length 2
+  defb 0x50     ; WR2: port B is memory, increment, timing byte follows
+  defb 0x02     ;      cycle length 2 (no prescaler: a prescaled transfer is
+                ;      slower than the LDI copy at 28 MHz)
+  defb 0xCD     ; WR4: burst mode, port B address follows
+dma_burst_dst:
+  defw 0
+  defb 0x82     ; WR5: stop at end of block
+  defb 0xCF     ; WR6: load
+  defb 0x87     ; WR6: enable DMA
+dma_burst_end:
@@ -270,6 +270,17 @@ void zxn_gotoxy(uint8_t uiX, uint8_t uiY)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* zxn_inverse()                                                              */
+/*----------------------------------------------------------------------------*/
+void zxn_inverse(bool bOn)
+{
+  /* 20,n - Enable/disable inverse video (see zxn_gotoxy()) */
+  putchar(0x14);
+  putchar(bOn ? 1 : 0);
+}
+
+
 /*----------------------------------------------------------------------------*/
 /* msbidx8()                                                                  */
 /*----------------------------------------------------------------------------*/
@@ -293,6 +304,24 @@ int8_t msbidx8(uint8_t uiValue)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* zxn_memcpy()                                                               */
+/*----------------------------------------------------------------------------*/
+void* zxn_memcpy(void* pDst, const void* pSrc, uint16_t uiLen)
+{
+  if (uiZXN_DMA_MIN <= uiLen)
+  {
+    zxn_dma_copy(pDst, pSrc, uiLen);
+  }
+  else
+  {
+    zxn_ldi(pDst, pSrc, uiLen);
+  }
+
+  return pDst;
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,218 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: archive.c                                                          |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bindump.h"
+#include "archive.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* archiveCreate()                                                            */
+/*----------------------------------------------------------------------------*/
+int archiveCreate(const region_t* pRegion, uint8_t uiCount, const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if ((0 != pRegion) && (0 != pFile))
+  {
+    if (INV_FILE_HND != pFile->hFile)
+    {
+      archiveheader_t tHeader;
+      archiveentry_t  tEntry;
+
+      memset(&tHeader, 0, sizeof(tHeader));
+      memcpy(tHeader.acMagic, acARCHIVE_MAGIC, sizeof(tHeader.acMagic));
+      tHeader.uiVersion = uiARCHIVE_VERSION;
+      tHeader.uiCount   = uiCount;
+
+      if (sizeof(tHeader) != esx_f_write(pFile->hFile, &tHeader, sizeof(tHeader)))
+      {
+        iReturn = EBADF;
+      }
+
+      memset(&tEntry, 0, sizeof(tEntry));
+      tEntry.uiData = sizeof(archiveheader_t) + (((uint32_t) uiCount) * sizeof(archiveentry_t));
+
+      for (uint8_t i = 0; (EOK == iReturn) && (i < uiCount); ++i)
+      {
+        tEntry.uiSource = (uint8_t) pRegion[i].eMode;
+        tEntry.uiOffset = pRegion[i].uiOffset;
+        tEntry.uiSize   = pRegion[i].uiSize;
+
+        if (sizeof(tEntry) != esx_f_write(pFile->hFile, &tEntry, sizeof(tEntry)))
+        {
+          iReturn = EBADF;
+        }
+
+        tEntry.uiData += tEntry.uiSize;
+      }
+    }
+    else
+    {
+      iReturn = ESTAT;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* archiveSelect()                                                            */
+/*----------------------------------------------------------------------------*/
+int archiveSelect(uint8_t uiIndex, archiveentry_t* pEntry, fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if ((0 != pEntry) && (0 != pFile))
+  {
+    if (INV_FILE_HND != pFile->hFile)
+    {
+      archiveheader_t tHeader;
+
+      if (EOK == iReturn)
+      {
+        if (UINT32_C(-1) == esx_f_seek(pFile->hFile, 0, ESX_SEEK_SET))
+        {
+          iReturn = EBADF;
+        }
+      }
+
+      if (EOK == iReturn)
+      {
+        if (sizeof(tHeader) != esx_f_read(pFile->hFile, &tHeader, sizeof(tHeader)))
+        {
+          iReturn = EBADF;
+        }
+        else if ((0 != memcmp(tHeader.acMagic, acARCHIVE_MAGIC, sizeof(tHeader.acMagic))) ||
+                 (uiARCHIVE_VERSION != tHeader.uiVersion))
+        {
+          iReturn = ENOTSUP; /* Error: no archive */
+        }
+        else if (uiIndex >= tHeader.uiCount)
+        {
+          iReturn = ERANGE;
+        }
+      }
+
+      /* Seek directly to the entry of the region */
+      if (EOK == iReturn)
+      {
+        uint32_t uiPos = sizeof(archiveheader_t) + (((uint32_t) uiIndex) * sizeof(archiveentry_t));
+
+        if (UINT32_C(-1) == esx_f_seek(pFile->hFile, uiPos, ESX_SEEK_SET))
+        {
+          iReturn = EBADF;
+        }
+      }
+
+      if (EOK == iReturn)
+      {
+        if (sizeof(*pEntry) != esx_f_read(pFile->hFile, pEntry, sizeof(*pEntry)))
+        {
+          iReturn = EBADF;
+        }
+      }
+
+      /* Position of the file has been changed */
+      pFile->uiPos = uiPOS_UNKNOWN;
+    }
+    else
+    {
+      iReturn = ESTAT;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -41,6 +41,7 @@
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <arch/zxn.h>
 #include <arch/zxn/esxdos.h>
 
@@ -109,6 +110,39 @@ int byte2hex(uint8_t uiByte, char_t* acHex)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* long2hex()                                                                 */
+/*----------------------------------------------------------------------------*/
+int long2hex(uint32_t uiValue, char_t* acHex)
+{
+  if (0 != acHex)
+  {
+    /* Z80 is little endian: access the bytes directly instead of shifting */
+    const uint8_t* pByte = (const uint8_t*) &uiValue;
+
+    byte2hex(pByte[3], &acHex[0]);
+    byte2hex(pByte[2], &acHex[2]);
+    byte2hex(pByte[1], &acHex[4]);
+    byte2hex(pByte[0], &acHex[6]);
+    return EOK;
+  }
+
+  return EINVAL;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* hasExtension()                                                             */
+/*----------------------------------------------------------------------------*/
+bool hasExtension(const char_t* acPathName, const char_t* acExt)
+{
+  size_t uiLen = strlen(acPathName);
+  size_t uiExt = strlen(acExt);
+
+  return ((uiLen > uiExt) && (0 == stricmp(&acPathName[uiLen - uiExt], acExt)));
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
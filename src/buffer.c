@@ -0,0 +1,268 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: buffer.c                                                           |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bindump.h"
+#include "buffer.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Banks of the stage buffers (index: bufid_t)
+*/
+static uint8_t g_uiBuffer[BUFFER_COUNT] = {uiBUFFER_NONE, uiBUFFER_NONE, uiBUFFER_NONE};
+
+/*!
+All banks allocated from NextOS (uiBUFFER_NONE = free entry)
+*/
+static uint8_t g_uiPages[uiBUFFER_PAGES];
+
+/*!
+Original page of MMU6 while a buffer is mapped (uiBUFFER_NONE = not mapped)
+*/
+static uint8_t g_uiMmu = uiBUFFER_NONE;
+
+/*!
+If this flag is set, the table of banks is initialized
+*/
+static bool g_bInit = false;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* bufferInit()                                                               */
+/*----------------------------------------------------------------------------*/
+int bufferInit(void)
+{
+  int iReturn = EOK;
+
+  for (uint8_t i = 0; i < BUFFER_COUNT; ++i)
+  {
+    if (uiBUFFER_NONE == g_uiBuffer[i])
+    {
+      if (uiBUFFER_NONE == (g_uiBuffer[i] = bufferAlloc()))
+      {
+        iReturn = ENOMEM;
+      }
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bufferFree()                                                               */
+/*----------------------------------------------------------------------------*/
+void bufferFree(void)
+{
+  if (g_bInit)
+  {
+    bufferUnmap();
+
+    for (uint8_t i = 0; i < uiBUFFER_PAGES; ++i)
+    {
+      if (uiBUFFER_NONE != g_uiPages[i])
+      {
+        (void) esx_ide_bank_free(ESX_BANKTYPE_RAM, g_uiPages[i]);
+        g_uiPages[i] = uiBUFFER_NONE;
+      }
+    }
+
+    memset(g_uiBuffer, uiBUFFER_NONE, sizeof(g_uiBuffer));
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bufferAvailable()                                                          */
+/*----------------------------------------------------------------------------*/
+bool bufferAvailable(bufid_t eBuffer)
+{
+  return (BUFFER_COUNT > eBuffer) && (uiBUFFER_NONE != g_uiBuffer[eBuffer]);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bufferMap()                                                                */
+/*----------------------------------------------------------------------------*/
+uint8_t* bufferMap(bufid_t eBuffer)
+{
+  uint8_t* pReturn = 0;
+
+  if (bufferAvailable(eBuffer))
+  {
+    pReturn = bufferMapPage(g_uiBuffer[eBuffer]);
+  }
+
+  return pReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bufferMapPage()                                                            */
+/*----------------------------------------------------------------------------*/
+uint8_t* bufferMapPage(uint8_t uiPage)
+{
+  /* Only the page mapped before the first bank is restored */
+  if (uiBUFFER_NONE == g_uiMmu)
+  {
+    g_uiMmu = ZXN_READ_REG(REG_MMU6);
+  }
+
+  ZXN_WRITE_REG(REG_MMU6, uiPage);
+
+  return (uint8_t*) zxn_memmap(uiBUFFER_ADDR);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bufferUnmap()                                                              */
+/*----------------------------------------------------------------------------*/
+void bufferUnmap(void)
+{
+  if (uiBUFFER_NONE != g_uiMmu)
+  {
+    ZXN_WRITE_REG(REG_MMU6, g_uiMmu);
+    g_uiMmu = uiBUFFER_NONE;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bufferAlloc()                                                              */
+/*----------------------------------------------------------------------------*/
+uint8_t bufferAlloc(void)
+{
+  uint8_t uiReturn = uiBUFFER_NONE;
+
+  if (!g_bInit)
+  {
+    memset(g_uiPages, uiBUFFER_NONE, sizeof(g_uiPages));
+    g_bInit = true;
+  }
+
+  for (uint8_t i = 0; i < uiBUFFER_PAGES; ++i)
+  {
+    if (uiBUFFER_NONE == g_uiPages[i])
+    {
+      uiReturn = esx_ide_bank_alloc(ESX_BANKTYPE_RAM);
+      g_uiPages[i] = uiReturn;
+      break;
+    }
+  }
+
+  return uiReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bufferRelease()                                                            */
+/*----------------------------------------------------------------------------*/
+void bufferRelease(uint8_t uiPage)
+{
+  if (uiBUFFER_NONE != uiPage)
+  {
+    (void) esx_ide_bank_free(ESX_BANKTYPE_RAM, uiPage);
+
+    bufferKeep(uiPage);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* bufferKeep()                                                               */
+/*----------------------------------------------------------------------------*/
+void bufferKeep(uint8_t uiPage)
+{
+  if (uiBUFFER_NONE != uiPage)
+  {
+    for (uint8_t i = 0; i < uiBUFFER_PAGES; ++i)
+    {
+      if (uiPage == g_uiPages[i])
+      {
+        g_uiPages[i] = uiBUFFER_NONE;
+        break;
+      }
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,361 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: capture.c                                                          |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bindump.h"
+#include "read.h"
+#include "archive.h"
+#include "buffer.h"
+#include "capture.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of a 8K bank of NextOS
+*/
+#define uiCAPTURE_PAGE_SIZE (0x2000)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Header of the current capture
+*/
+static captureheader_t g_tHeader;
+
+/*!
+If this flag is set, the banks of "g_tHeader" belong to the current capture
+*/
+static bool g_bOpen = false;
+
+/*!
+Position of the next byte to write in the banks of the capture
+*/
+static uint32_t g_uiPos = 0;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Copy data to the banks of the capture (at the current position)
+@param pData Pointer to the data
+@param uiLen Length of the data
+*/
+static void writeBanks(const void* pData, uint16_t uiLen);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* captureOpen()                                                              */
+/*----------------------------------------------------------------------------*/
+int captureOpen(const region_t* pRegion, uint8_t uiCount, bool bArchive)
+{
+  int iReturn = EOK;
+
+  if ((0 != pRegion) && (0 < uiCount) && (uiMAX_REGIONS >= uiCount) && !g_bOpen)
+  {
+    uint32_t uiSize = 0;
+
+    memset(&g_tHeader, 0, sizeof(g_tHeader));
+    memset(g_tHeader.uiPage, 0xFF, sizeof(g_tHeader.uiPage));
+
+    for (uint8_t i = 0; i < uiCount; ++i)
+    {
+      uiSize += pRegion[i].uiSize;
+    }
+
+    /* Header and data are saved without gaps */
+    if ((((uint32_t) uiCAPTURE_PAGES) * uiCAPTURE_PAGE_SIZE - sizeof(g_tHeader)) < uiSize)
+    {
+      iReturn = EFBIG;
+    }
+
+    if (EOK == iReturn)
+    {
+      uint8_t uiPages = (uint8_t) ((sizeof(g_tHeader) + uiSize + uiCAPTURE_PAGE_SIZE - 1) / uiCAPTURE_PAGE_SIZE);
+
+      g_bOpen = true;
+
+      for (uint8_t i = 0; i < uiPages; ++i)
+      {
+        if (0xFF == (g_tHeader.uiPage[i] = bufferAlloc()))
+        {
+          iReturn = ENOMEM;
+          break;
+        }
+
+        ++g_tHeader.uiPages;
+      }
+    }
+
+    if (EOK == iReturn)
+    {
+      memcpy(g_tHeader.acMagic, acCAPTURE_MAGIC, sizeof(g_tHeader.acMagic));
+      memcpy(g_tHeader.tRegion, pRegion, uiCount * sizeof(region_t));
+      g_tHeader.uiVersion = uiCAPTURE_VERSION;
+      g_tHeader.uiRegions = uiCount;
+      g_tHeader.bArchive  = bArchive;
+      g_tHeader.uiSize    = uiSize;
+
+      g_uiPos = 0;
+      writeBanks(&g_tHeader, sizeof(g_tHeader));
+    }
+    else
+    {
+      captureClose(false);
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* captureRegion()                                                            */
+/*----------------------------------------------------------------------------*/
+int captureRegion(source_t* pSource, const region_t* pRegion)
+{
+  int iReturn = EOK;
+
+  if ((0 != pSource) && (0 != pRegion) && g_bOpen)
+  {
+    uint32_t uiPos = 0;
+
+    while ((EOK == iReturn) && (uiPos < pRegion->uiSize))
+    {
+      uint16_t uiLen = ((pRegion->uiSize - uiPos) > uiBLOCK_SIZE ? uiBLOCK_SIZE : (uint16_t) (pRegion->uiSize - uiPos));
+
+      if (EOK == (iReturn = readBlock(pSource, pRegion->uiOffset + uiPos, uiLen)))
+      {
+        writeBanks(pSource->pBlock, uiLen);
+      }
+
+      uiPos += uiLen;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* captureAttach()                                                            */
+/*----------------------------------------------------------------------------*/
+int captureAttach(uint8_t uiBank)
+{
+  int iReturn = EOK;
+
+  if (!g_bOpen)
+  {
+    memcpy(&g_tHeader, bufferMapPage(uiBank), sizeof(g_tHeader));
+    bufferUnmap();
+
+    if ((0 != memcmp(g_tHeader.acMagic, acCAPTURE_MAGIC, sizeof(g_tHeader.acMagic))) ||
+        (uiCAPTURE_VERSION != g_tHeader.uiVersion) ||
+        (uiBank != g_tHeader.uiPage[0]))
+    {
+      iReturn = ENOTSUP; /* Error: no capture */
+    }
+    else
+    {
+      g_bOpen = true;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* captureInfo()                                                              */
+/*----------------------------------------------------------------------------*/
+const captureheader_t* captureInfo(void)
+{
+  return &g_tHeader;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* captureFlush()                                                             */
+/*----------------------------------------------------------------------------*/
+int captureFlush(const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if ((0 != pFile) && g_bOpen)
+  {
+    uint32_t uiPos = sizeof(g_tHeader);
+    uint32_t uiEnd = uiPos + g_tHeader.uiSize;
+
+    if (g_tHeader.bArchive)
+    {
+      iReturn = archiveCreate(g_tHeader.tRegion, g_tHeader.uiRegions, pFile);
+    }
+
+    /* The data is written directly from the mapped banks */
+    while ((EOK == iReturn) && (uiPos < uiEnd))
+    {
+      uint16_t uiOfs = ((uint16_t) uiPos) & (uiCAPTURE_PAGE_SIZE - 1);
+      uint16_t uiLen = uiCAPTURE_PAGE_SIZE - uiOfs;
+
+      if ((uiEnd - uiPos) < uiLen)
+      {
+        uiLen = (uint16_t) (uiEnd - uiPos);
+      }
+
+      if (uiLen != esx_f_write(pFile->hFile, bufferMapPage(g_tHeader.uiPage[(uint8_t) (uiPos / uiCAPTURE_PAGE_SIZE)]) + uiOfs, uiLen))
+      {
+        iReturn = EBADF;
+      }
+
+      bufferUnmap();
+
+      uiPos += uiLen;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* captureClose()                                                             */
+/*----------------------------------------------------------------------------*/
+void captureClose(bool bKeep)
+{
+  if (g_bOpen)
+  {
+    for (uint8_t i = 0; i < uiCAPTURE_PAGES; ++i)
+    {
+      if (0xFF != g_tHeader.uiPage[i])
+      {
+        if (bKeep)
+        {
+          bufferKeep(g_tHeader.uiPage[i]);
+        }
+        else
+        {
+          bufferRelease(g_tHeader.uiPage[i]);
+          g_tHeader.uiPage[i] = 0xFF;
+        }
+      }
+    }
+  }
+
+  g_bOpen = false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* writeBanks()                                                               */
+/*----------------------------------------------------------------------------*/
+static void writeBanks(const void* pData, uint16_t uiLen)
+{
+  const uint8_t* pSrc = (const uint8_t*) pData;
+
+  while (0 < uiLen)
+  {
+    uint16_t uiOfs   = ((uint16_t) g_uiPos) & (uiCAPTURE_PAGE_SIZE - 1);
+    uint16_t uiChunk = uiCAPTURE_PAGE_SIZE - uiOfs;
+
+    if (uiLen < uiChunk)
+    {
+      uiChunk = uiLen;
+    }
+
+    zxn_memcpy(bufferMapPage(g_tHeader.uiPage[(uint8_t) (g_uiPos / uiCAPTURE_PAGE_SIZE)]) + uiOfs, pSrc, uiChunk);
+
+    g_uiPos += uiChunk;
+    pSrc    += uiChunk;
+    uiLen   -= uiChunk;
+  }
+
+  bufferUnmap();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,323 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: changelog.c                                                        |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bindump.h"
+#include "read.h"
+#include "save.h"
+#include "buffer.h"
+#include "changelog.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of a 8K bank of NextOS
+*/
+#define uiLOG_PAGE_SIZE (0x2000)
+
+/*!
+Number of 8K banks for the last sample
+*/
+#define uiLOG_PAGES ((uint8_t) (uiLOG_MAX_SIZE / uiLOG_PAGE_SIZE))
+
+/*!
+Address of the system variable FRAMES (3 bytes, incremented every frame)
+*/
+#define uiSYSVAR_FRAMES (0x5C78)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Region to sample
+*/
+static uint32_t g_uiOffset = 0;
+static uint32_t g_uiSize   = 0;
+
+/*!
+If this flag is set, the next sample is the first one and saved completely
+*/
+static bool g_bFirst = true;
+
+/*!
+Banks of NextOS with the last sample (0xFF = not allocated)
+*/
+static uint8_t g_uiPage[uiLOG_PAGES] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Compare a block of the current sample with the last sample and append the
+changed range to the output buffer.
+@param pData Pointer to the block of the current sample
+@param uiPos Position of the block in the region
+@param uiLen Length of the block
+@param uiFrame Frame counter of the sample
+@param pFile Pointer to the fileinfo of the open output file
+@return EOK = no error
+*/
+static int compareBlock(const uint8_t* pData, uint32_t uiPos, uint16_t uiLen, uint32_t uiFrame, const fileinfo_t* pFile);
+
+/*!
+Read the frame counter of the system (FRAMES)
+@return Number of frames since power on (24 bit)
+*/
+static uint32_t frameCounter(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* logOpen()                                                                  */
+/*----------------------------------------------------------------------------*/
+int logOpen(const region_t* pRegion, uint8_t uiFrames, const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if ((0 != pRegion) && (0 != pFile))
+  {
+    if (INV_FILE_HND == pFile->hFile)
+    {
+      iReturn = ESTAT;
+    }
+    else if ((0 == pRegion->uiSize) || (uiLOG_MAX_SIZE < pRegion->uiSize))
+    {
+      iReturn = ERANGE;
+    }
+
+    /* One bank for each 8K of the region */
+    if (EOK == iReturn)
+    {
+      for (uint8_t i = 0; i < (uint8_t) ((pRegion->uiSize + uiLOG_PAGE_SIZE - 1) / uiLOG_PAGE_SIZE); ++i)
+      {
+        if (0xFF == (g_uiPage[i] = bufferAlloc()))
+        {
+          iReturn = ENOMEM;
+          break;
+        }
+      }
+    }
+
+    if (EOK == iReturn)
+    {
+      logheader_t tHeader;
+
+      memset(&tHeader, 0, sizeof(tHeader));
+      memcpy(tHeader.acMagic, acLOG_MAGIC, sizeof(tHeader.acMagic));
+      tHeader.uiVersion = uiLOG_VERSION;
+      tHeader.uiSource  = (uint8_t) pRegion->eMode;
+      tHeader.uiFrames  = uiFrames;
+      tHeader.uiOffset  = pRegion->uiOffset;
+      tHeader.uiSize    = pRegion->uiSize;
+
+      g_uiOffset = pRegion->uiOffset;
+      g_uiSize   = pRegion->uiSize;
+      g_bFirst   = true;
+
+      iReturn = saveBlock((const uint8_t*) &tHeader, sizeof(tHeader), pFile);
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* logSample()                                                                */
+/*----------------------------------------------------------------------------*/
+int logSample(source_t* pSource, const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if ((0 != pSource) && (0 != pFile))
+  {
+    uint32_t uiFrame = frameCounter();
+    uint32_t uiPos   = 0;
+
+    while ((EOK == iReturn) && (uiPos < g_uiSize))
+    {
+      uint16_t uiLen = ((g_uiSize - uiPos) > uiBLOCK_SIZE ? uiBLOCK_SIZE : (uint16_t) (g_uiSize - uiPos));
+
+      if (EOK == (iReturn = readBlock(pSource, g_uiOffset + uiPos, uiLen)))
+      {
+        iReturn = compareBlock(pSource->pBlock, uiPos, uiLen, uiFrame, pFile);
+      }
+
+      uiPos += uiLen;
+    }
+
+    g_bFirst = false;
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* logClose()                                                                 */
+/*----------------------------------------------------------------------------*/
+int logClose(const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if ((0 != pFile) && (INV_FILE_HND != pFile->hFile))
+  {
+    iReturn = saveFlush(pFile);
+  }
+
+  for (uint8_t i = 0; i < uiLOG_PAGES; ++i)
+  {
+    if (0xFF != g_uiPage[i])
+    {
+      bufferRelease(g_uiPage[i]);
+      g_uiPage[i] = 0xFF;
+    }
+  }
+
+  g_uiSize = 0;
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* compareBlock()                                                             */
+/*----------------------------------------------------------------------------*/
+static int compareBlock(const uint8_t* pData, uint32_t uiPos, uint16_t uiLen, uint32_t uiFrame, const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  uint16_t uiFirst = 0;
+  uint16_t uiLast  = uiLen;
+
+  /* Blocks never cross a bank boundary (uiLOG_PAGE_SIZE % uiBLOCK_SIZE == 0) */
+  uint8_t* pLast   = bufferMapPage(g_uiPage[(uint8_t) (uiPos / uiLOG_PAGE_SIZE)]) + (((uint16_t) uiPos) & (uiLOG_PAGE_SIZE - 1));
+
+  if (!g_bFirst)
+  {
+    uiFirst = zxn_mismatch(pData, pLast, uiLen);
+
+    if (uiFirst < uiLen)
+    {
+      while (pData[uiLast - 1] == pLast[uiLast - 1])
+      {
+        --uiLast;
+      }
+    }
+  }
+
+  if (uiFirst < uiLen)
+  {
+    memcpy(&pLast[uiFirst], &pData[uiFirst], uiLast - uiFirst);
+  }
+
+  bufferUnmap();
+
+  if (uiFirst < uiLen)
+  {
+    logrecord_t tRecord;
+
+    tRecord.uiFrame = uiFrame;
+    tRecord.uiAddr  = g_uiOffset + uiPos + uiFirst;
+    tRecord.uiLen   = uiLast - uiFirst;
+
+    if (EOK == (iReturn = saveBlock((const uint8_t*) &tRecord, sizeof(tRecord), pFile)))
+    {
+      iReturn = saveBlock(&pData[uiFirst], tRecord.uiLen, pFile);
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* frameCounter()                                                             */
+/*----------------------------------------------------------------------------*/
+static uint32_t frameCounter(void)
+{
+  const uint8_t* pFrames = (const uint8_t*) zxn_memmap(uiSYSVAR_FRAMES);
+
+  return ((uint32_t) pFrames[0])         |
+         (((uint32_t) pFrames[1]) << 8)  |
+         (((uint32_t) pFrames[2]) << 16);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
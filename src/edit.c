@@ -0,0 +1,395 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: edit.c                                                             |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bindump.h"
+#include "read.h"
+#include "buffer.h"
+#include "edit.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Mask of the address of a block
+*/
+#define uiEDIT_BLOCK_MASK (~((uint32_t) (uiEDIT_BLOCK_SIZE - 1)))
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Dirty block of the edit overlay (saved in the bank of the overlay)
+*/
+typedef struct _editblock
+{
+  /*!
+  Data of the block
+  */
+  uint8_t uiData[uiEDIT_BLOCK_SIZE];
+
+  /*!
+  Modified bytes of the block (one bit per byte)
+  */
+  uint8_t uiMask[uiEDIT_BLOCK_SIZE / 8];
+} editblock_t;
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Bank of the dirty blocks (uiBUFFER_NONE = not allocated)
+*/
+static uint8_t g_uiPage = uiBUFFER_NONE;
+
+/*!
+Number of dirty blocks
+*/
+static uint8_t g_uiBlocks = 0;
+
+/*!
+Addresses of the dirty blocks
+*/
+static uint32_t g_uiAddr[uiEDIT_BLOCKS];
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+This function searches the dirty block of an address.
+@param uiAddr Address of the block
+@return Index of the block (uiEDIT_BLOCKS = not found)
+*/
+static uint8_t findBlock(uint32_t uiAddr);
+
+/*!
+This function maps the bank of the overlay into MMU6 ("bufferUnmap()" restores
+the previous page).
+@return Pointer to the first block of the overlay
+*/
+static editblock_t* mapBlocks(void);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* editOpen()                                                                 */
+/*----------------------------------------------------------------------------*/
+int editOpen(void)
+{
+  int iReturn = EOK;
+
+  if (uiBUFFER_NONE == g_uiPage)
+  {
+    g_uiBlocks = 0;
+
+    if (uiBUFFER_NONE == (g_uiPage = bufferAlloc()))
+    {
+      iReturn = ENOMEM;
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* editClose()                                                                */
+/*----------------------------------------------------------------------------*/
+void editClose(void)
+{
+  if (uiBUFFER_NONE != g_uiPage)
+  {
+    bufferRelease(g_uiPage);
+    g_uiPage = uiBUFFER_NONE;
+  }
+
+  g_uiBlocks = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* editPoke()                                                                 */
+/*----------------------------------------------------------------------------*/
+int editPoke(uint32_t uiAddr, uint8_t uiValue)
+{
+  int iReturn = EOK;
+
+  if (uiBUFFER_NONE != g_uiPage)
+  {
+    uint8_t uiIdx = findBlock(uiAddr & uiEDIT_BLOCK_MASK);
+
+    /* New dirty block: nothing is modified yet */
+    if ((uiEDIT_BLOCKS == uiIdx) && (uiEDIT_BLOCKS > g_uiBlocks))
+    {
+      uiIdx = g_uiBlocks++;
+      g_uiAddr[uiIdx] = uiAddr & uiEDIT_BLOCK_MASK;
+      memset(mapBlocks()[uiIdx].uiMask, 0, uiEDIT_BLOCK_SIZE / 8);
+
+      bufferUnmap();
+    }
+
+    if (uiEDIT_BLOCKS != uiIdx)
+    {
+      editblock_t* pBlock = &mapBlocks()[uiIdx];
+      uint8_t      uiOfs  = (uint8_t) uiAddr;
+
+      pBlock->uiData[uiOfs] = uiValue;
+      pBlock->uiMask[uiOfs >> 3] |= (1 << (uiOfs & 7));
+
+      bufferUnmap();
+    }
+    else
+    {
+      iReturn = ENOMEM; /* Error: overlay is full */
+    }
+  }
+  else
+  {
+    iReturn = EBADF;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* editApply()                                                                */
+/*----------------------------------------------------------------------------*/
+void editApply(readbuffer_t* pRead)
+{
+  uint8_t uiIdx;
+
+  /* The frames are aligned to the stride, so a frame is part of one block */
+  if ((0 != g_uiBlocks) && (0 != pRead) &&
+      (uiEDIT_BLOCKS != (uiIdx = findBlock(pRead->uiAddr & uiEDIT_BLOCK_MASK))))
+  {
+    editblock_t* pBlock = &mapBlocks()[uiIdx];
+    uint8_t      uiOfs  = (uint8_t) pRead->uiAddr;
+
+    for (uint8_t i = 0; i < pRead->uiStride; ++i, ++uiOfs)
+    {
+      if (0 != (pBlock->uiMask[uiOfs >> 3] & (1 << (uiOfs & 7))))
+      {
+        pRead->uiData[i] = pBlock->uiData[uiOfs];
+      }
+    }
+
+    bufferUnmap();
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* editPatch()                                                                */
+/*----------------------------------------------------------------------------*/
+void editPatch(uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  if ((0 != g_uiBlocks) && (0 != pData) && (0 < uiLen))
+  {
+    editblock_t* pBlocks = mapBlocks();
+
+    for (uint8_t i = 0; i < g_uiBlocks; ++i)
+    {
+      /* Part of the dirty block within the data */
+      uint32_t uiFirst = (g_uiAddr[i] > uiAddr ? g_uiAddr[i] : uiAddr);
+      uint32_t uiLast  = g_uiAddr[i] + uiEDIT_BLOCK_SIZE;
+
+      if (uiLast > (uiAddr + uiLen))
+      {
+        uiLast = uiAddr + uiLen;
+      }
+
+      if (uiFirst < uiLast)
+      {
+        editblock_t* pBlock = &pBlocks[i];
+        uint8_t*     pByte  = &pData[(uint16_t) (uiFirst - uiAddr)];
+        uint8_t      uiOfs  = (uint8_t) uiFirst;
+
+        for (uint16_t j = (uint16_t) (uiLast - uiFirst); 0 < j; --j, ++uiOfs, ++pByte)
+        {
+          if (0 != (pBlock->uiMask[uiOfs >> 3] & (1 << (uiOfs & 7))))
+          {
+            *pByte = pBlock->uiData[uiOfs];
+          }
+        }
+      }
+    }
+
+    bufferUnmap();
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* editCount()                                                                */
+/*----------------------------------------------------------------------------*/
+uint8_t editCount(void)
+{
+  return g_uiBlocks;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* editSave()                                                                 */
+/*----------------------------------------------------------------------------*/
+int editSave(source_t* pSource)
+{
+  int iReturn = EOK;
+
+  /* The last block is written first; a saved block is removed at once */
+  while ((EOK == iReturn) && (0 < g_uiBlocks))
+  {
+    uint8_t      uiIdx   = g_uiBlocks - 1;
+    editblock_t* pBlock  = &mapBlocks()[uiIdx];
+    uint16_t     uiFirst = uiEDIT_BLOCK_SIZE;
+    uint16_t     uiLast  = 0;
+    uint8_t      uiMask[uiEDIT_BLOCK_SIZE / 8];
+
+    /* Range of the modified bytes */
+    for (uint16_t i = 0; i < uiEDIT_BLOCK_SIZE; ++i)
+    {
+      if (0 != (pBlock->uiMask[i >> 3] & (1 << (i & 7))))
+      {
+        uiFirst = (uiFirst > i ? i : uiFirst);
+        uiLast  = i;
+      }
+    }
+
+    memcpy(uiMask, pBlock->uiMask, sizeof(uiMask));
+    bufferUnmap();
+
+    if (uiFirst <= uiLast)
+    {
+      uint16_t uiLen = uiLast - uiFirst + 1;
+
+      /* Unmodified bytes of the range are taken from the datasource */
+      if (EOK == (iReturn = readBlock(pSource, g_uiAddr[uiIdx] + uiFirst, uiLen)))
+      {
+        pBlock = &mapBlocks()[uiIdx];
+
+        for (uint16_t i = uiFirst; i <= uiLast; ++i)
+        {
+          if (0 != (uiMask[i >> 3] & (1 << (i & 7))))
+          {
+            pSource->pBlock[i - uiFirst] = pBlock->uiData[i];
+          }
+        }
+
+        bufferUnmap();
+
+        iReturn = sourceWrite(pSource, g_uiAddr[uiIdx] + uiFirst, pSource->pBlock, uiLen);
+      }
+    }
+
+    if (EOK == iReturn)
+    {
+      --g_uiBlocks;
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* editDiscard()                                                              */
+/*----------------------------------------------------------------------------*/
+void editDiscard(void)
+{
+  g_uiBlocks = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* findBlock()                                                                */
+/*----------------------------------------------------------------------------*/
+static uint8_t findBlock(uint32_t uiAddr)
+{
+  uint8_t uiReturn = uiEDIT_BLOCKS;
+
+  for (uint8_t i = 0; i < g_uiBlocks; ++i)
+  {
+    if (uiAddr == g_uiAddr[i])
+    {
+      uiReturn = i;
+      break;
+    }
+  }
+
+  return uiReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* mapBlocks()                                                                */
+/*----------------------------------------------------------------------------*/
+static editblock_t* mapBlocks(void)
+{
+  return (editblock_t*) bufferMapPage(g_uiPage);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
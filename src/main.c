@@ -41,9 +41,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <malloc.h>
 #include <errno.h>
 #include <input.h>
+#include <intrinsic.h>
 #include <input/input_zx.h>
 #include <arch/zxn.h>
 #include <arch/zxn/esxdos.h>
@@ -55,11 +57,23 @@
 #include "read.h"
 #include "render.h"
 #include "save.h"
+#include "archive.h"
+#include "snapshot.h"
+#include "tape.h"
+#include "unpack.h"
+#include "changelog.h"
+#include "capture.h"
+#include "buffer.h"
+#include "edit.h"
 #include "version.h"
 
 /*============================================================================*/
 /*                               Defines                                      */
 /*============================================================================*/
+/*!
+Directory, to which the selection of the interactive mode is exported
+*/
+#define acEXPORT_DIR "."
 
 /*============================================================================*/
 /*                               Namespaces                                   */
@@ -133,6 +147,192 @@ This function dump data interactively to screen
 */
 int dumpInteractive(void);
 
+/*!
+This function dumps all regions to one archive file
+*/
+int dumpArchive(void);
+
+/*!
+This function samples the region periodically and saves the changes to a
+change-log file until a key is pressed
+*/
+int dumpLog(void);
+
+/*!
+This function captures all regions to RAM banks and saves them afterwards to
+the output file. Without output file the banks are kept for option -u.
+*/
+int dumpCapture(void);
+
+/*!
+This function saves a capture of a previous invocation to the output file and
+releases it's banks.
+*/
+int unloadCapture(void);
+
+/*!
+This function adds a region to the list of regions to dump
+@param eMode Datasource of the region
+@param uiOffset Startoffset of the region
+@return EOK = no error
+*/
+static int addRegion(dumpmode_t eMode, uint32_t uiOffset);
+
+/*!
+This function limits a region to the size of the datasource
+@param pOffset [IN/OUT] Startoffset of the region
+@param pSize [IN/OUT] Length of the region
+@param uiLimit Size of the datasource
+*/
+static void clipRegion(uint32_t* pOffset, uint32_t* pSize, uint32_t uiLimit);
+
+/*!
+This function calculates the bounds of the region to read
+@param uiOffset Startoffset of the region
+@param uiSize Length of the region
+*/
+static void setBounds(uint32_t uiOffset, uint32_t uiSize);
+
+/*!
+This function opens the output file. If the output argument is a directory, a
+new file with an unused name is created in it.
+@return EOK = no error
+*/
+static int openOutput(void);
+
+/*!
+This function checks, if the output argument is a directory. If so, the
+directory is read once and the next unused index for the names of the output
+files ("bindump-<index>.<ext>") is detected.
+*/
+static void scanOutputDir(void);
+
+/*!
+This function sorts the list of regions by datasource and address, so that
+each datasource is read sequentially.
+*/
+static void sortRegions(void);
+
+/*!
+This function reads a list of regions from a file. Each line of the file
+describes one region: "[l|p|f|n|c|t|d] offset size"
+@param acPathName Pathname of the list file
+@return EOK = no error
+*/
+static int readRegions(const char_t* acPathName);
+
+/*!
+This function parses one line of a list of regions
+@param acLine Line to parse
+@return EOK = no error
+*/
+static int parseRegion(char_t* acLine);
+
+/*!
+This function selects the datasource of the next region. The datasource is only
+reopened, if it differs from the current one.
+@param eMode Type of the datasource
+@return EOK = no error
+*/
+static int selectSource(dumpmode_t eMode);
+
+/*!
+This function copies the current region in blocks from the datasource to the
+output file (raw mode).
+@return EOK = no error
+*/
+static int dumpRaw(void);
+
+/*!
+This function calculates the address of the next/previous block of a tape
+image, that is part of the current region.
+@param uiAddr Current address
+@param bNext true = next block; false = previous block
+@return Address of the block (unchanged, if there is no such block)
+*/
+static uint32_t jumpBlock(uint32_t uiAddr, bool bNext);
+
+/*!
+This function reads the visible window again (watch mode) and compares it with
+the last sample. Only the changed bytes are redrawn (highlighted); bytes, that
+were highlighted in the last sample, are redrawn without highlight.
+@param uiAddr Address of the first row of the window
+@return EOK = no error
+*/
+static int watchSample(uint32_t uiAddr);
+
+/*!
+This function draws the decode panel beside the visible window. The labels are
+drawn only after a redraw of the window; otherwise only the values of the bytes
+under the cursor are decoded again.
+@param uiAddr Address of the first row of the window
+@param bLabels true = draw the labels too
+*/
+static void drawPanel(uint32_t uiAddr, bool bLabels);
+
+/*!
+This function draws a single byte of the visible window again (hex and ASCII
+cell) from the copy of the window. The cursor is shown by toggling inverse
+video, so a byte highlighted by the watch mode is shown normal under the
+cursor.
+@param uiAddr Address of the first row of the window
+@param uiIdx Index of the byte in the window
+@param bCursor true = the byte is under the cursor
+*/
+static void drawCell(uint32_t uiAddr, uint16_t uiIdx, bool bCursor);
+
+/*!
+This function shows a message in the last row of the screen (below the
+window).
+@param acText Message to show
+*/
+static void showStatus(const char_t* acText);
+
+/*!
+This function writes the selection of the interactive mode to a new file in
+the export directory. The range is read in blocks from the datasource; the
+bounds of the window are restored afterwards.
+@param bHex true = hex dump; false = raw data
+@return EOK = no error
+*/
+static int exportRange(bool bHex);
+
+/*!
+This function renders the current region in blocks from the datasource to the
+output file (hex mode); the frames are taken directly from the block buffer.
+@return EOK = no error
+*/
+static int dumpHex(void);
+
+/*!
+This function moves the cursor by a byte (h/l) or a line (k/j). Within the
+window only the old and the new cell are drawn again; at the edges of the
+window the window is scrolled by a line.
+@param pAddr Pointer to the address of the first row of the window
+@param iKey Key pressed (h, l, k, j)
+@return true = the window has been scrolled and has to be drawn again
+*/
+static bool moveCursor(uint32_t* pAddr, int iKey);
+
+/*!
+This function enters a hex digit into the byte under the cursor (edit mode).
+The first digit is the high nibble; after the second digit the cursor moves to
+the next byte. The byte is modified in the edit overlay and only it's cell is
+drawn again.
+@param pAddr Pointer to the address of the first row of the window
+@param iKey Key pressed (0-9, a-f)
+@return true = the window has been scrolled and has to be drawn again
+*/
+static bool editCursor(uint32_t* pAddr, int iKey);
+
+/*!
+This function checks, how many of the following frames in the block buffer
+repeat the last line, if the line consists of one value only (squeeze).
+@param pLast Last line shown
+@return Number of bytes after the current frame, that can be skipped
+*/
+static uint16_t squeezeFrames(const uint8_t* pLast);
+
 /*============================================================================*/
 /*                               Klassen                                      */
 /*============================================================================*/
@@ -154,8 +354,16 @@ void _construct(void)
     g_tState.bQuiet         = false;
     g_tState.bHex           = false;
     g_tState.bForce         = false;
+    g_tState.bArchive       = false;
+    g_tState.bIndex         = false;
     g_tState.eMode          = DUMP_NONE;
     g_tState.tRdFile.hFile  = INV_FILE_HND;
+    g_tState.tRdFile.hWrite = INV_FILE_HND;
+
+    for (uint8_t i = 0; i < uiMAX_CHECKPOINTS; ++i)
+    {
+      g_tState.tRdFile.tCheck[i].hFile = INV_FILE_HND;
+    }
     g_tState.tWrFile.hFile  = INV_FILE_HND;
     g_tState.uiCpuSpeed     = ZXN_READ_REG(REG_TURBO_MODE) & 0x03;
     g_tState.tScreen.uiCols = 32;
@@ -193,17 +401,20 @@ void _destruct(void)
 {
   if (g_tState.bInitialized)
   {
+    (void) logClose(&g_tState.tWrFile);
+    captureClose(false);
+
     if (INV_FILE_HND != g_tState.tWrFile.hFile)
     {
       (void) esx_f_close(g_tState.tWrFile.hFile);
       g_tState.tWrFile.hFile = INV_FILE_HND;
     }
 
-    if (INV_FILE_HND != g_tState.tRdFile.hFile)
-    {
-      (void) esx_f_close(g_tState.tRdFile.hFile);
-      g_tState.tRdFile.hFile = INV_FILE_HND;
-    }
+    sourceClose(&g_tState.tSource);
+    closeFile(&g_tState.tRdFile);
+
+    /* Return all banks to NextOS (also on error) */
+    bufferFree();
 
     ZXN_WRITE_REG(REG_TURBO_MODE, g_tState.uiCpuSpeed);
   }
@@ -235,8 +446,15 @@ int main(int argc, char* argv[])
         break;
 
       case ACTION_DUMP:
+        /* Large I/O buffers in 8K banks; without them small buffers are used */
+        (void) bufferInit();
         g_tState.iExitCode = dump();
         break;
+
+      case ACTION_UNLOAD:
+        (void) bufferInit();
+        g_tState.iExitCode = unloadCapture();
+        break;
     }
   }
 
@@ -255,13 +473,34 @@ int parseArguments(int argc, char* argv[])
   g_tState.eAction  = ACTION_NONE;
   g_tState.bQuiet   = false;
   g_tState.bHex     = false;
+  g_tState.bSqueeze = false;
+  g_tState.tRender.acFormat = 0;
   g_tState.bForce   = false;
+  g_tState.bArchive = false;
+  g_tState.bIndex   = false;
+  g_tState.uiIndex  = 0;
+  g_tState.bBank    = false;
+  g_tState.uiBank   = 0;
+  g_tState.bBlock   = false;
+  g_tState.uiBlock  = 0;
+  g_tState.bTape    = false;
+  g_tState.tWatch.uiFrames = 0;
+  g_tState.uiLog    = 0;
+  g_tState.bCapture = false;
+  g_tState.uiCapture = 0;
   g_tState.eMode    = DUMP_NONE;
   g_tState.uiOffset = 0;
   g_tState.uiSize   = 0;
+  g_tState.uiRegions = 0;
   g_tState.tRdFile.acPathName[0] = '\0';
   g_tState.tWrFile.acPathName[0] = '\0';
 
+  uint8_t uiSources = 0;
+
+  /* Offset/size of the last region already given */
+  bool bOffset = false;
+  bool bSize   = false;
+
   int i = 1;
   while (i < argc)
   {
@@ -285,45 +524,236 @@ int parseArguments(int argc, char* argv[])
       {
         g_tState.bQuiet = true;
       }
+      else if ((0 == strcmp(acArg, "-z")) || (0 == stricmp(acArg, "--squeeze")))
+      {
+        g_tState.bSqueeze = true;
+      }
+      else if ((0 == strcmp(acArg, "-e")) || (0 == stricmp(acArg, "--format")))
+      {
+        if ((i + 1) < argc)
+        {
+          /* Compiled once here to check it; renderSetup() compiles it again */
+          if (EOK == (iReturn = renderCompile(argv[++i], &g_tState.tRender)))
+          {
+            g_tState.tRender.acFormat = argv[i];
+          }
+          else
+          {
+            fprintf(stderr, "invalid format: %s\n", argv[i]);
+            break;
+          }
+        }
+        else
+        {
+          fprintf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
       else if ((0 == strcmp(acArg, "-r")) || (0 == stricmp(acArg, "--force")))
       {
         g_tState.bForce = true;
       }
-      else if ((0 == strcmp(acArg, "-l")) || (0 == stricmp(acArg, "--logical")))
+      else if ((0 == strcmp(acArg, "-a")) || (0 == stricmp(acArg, "--archive")))
+      {
+        g_tState.bArchive = true;
+      }
+      else if ((0 == strcmp(acArg, "-b")) || (0 == stricmp(acArg, "--batch")))
+      {
+        if ((i + 1) < argc)
+        {
+          if (EOK != (iReturn = readRegions(argv[++i])))
+          {
+            break;
+          }
+
+          /* The regions of the list are complete */
+          bOffset = true;
+          bSize   = true;
+        }
+        else
+        {
+          fprintf(stderr, "option %s requires a path argument\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-i")) || (0 == stricmp(acArg, "--index")))
+      {
+        if ((i + 1) < argc)
+        {
+          /* Index of the region, no silent wrap around */
+          unsigned long uiValue = strtoul(argv[++i], 0, 0);
+
+          if (uiMAX_REGIONS <= uiValue)
+          {
+            fprintf(stderr, "option %s requires a value (max. %u)\n", acArg, uiMAX_REGIONS - 1);
+            iReturn = EINVAL;
+            break;
+          }
+
+          g_tState.uiIndex = (uint8_t) uiValue;
+          g_tState.bIndex  = true;
+        }
+        else
+        {
+          fprintf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-k")) || (0 == stricmp(acArg, "--bank")))
+      {
+        if ((i + 1) < argc)
+        {
+          /* 16K bank of the snapshot, no silent wrap around */
+          unsigned long uiValue = strtoul(argv[++i], 0, 0);
+
+          if (uiSNAP_BANKS <= uiValue)
+          {
+            fprintf(stderr, "option %s requires a value (max. %u)\n", acArg, uiSNAP_BANKS - 1);
+            iReturn = EINVAL;
+            break;
+          }
+
+          g_tState.uiBank = (uint8_t) uiValue;
+          g_tState.bBank  = true;
+        }
+        else
+        {
+          fprintf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-j")) || (0 == stricmp(acArg, "--jump")))
+      {
+        if ((i + 1) < argc)
+        {
+          /* Index of the block, no silent wrap around */
+          unsigned long uiValue = strtoul(argv[++i], 0, 0);
+
+          if (uiTAPE_BLOCKS <= uiValue)
+          {
+            fprintf(stderr, "option %s requires a value (max. %u)\n", acArg, uiTAPE_BLOCKS - 1);
+            iReturn = EINVAL;
+            break;
+          }
+
+          g_tState.uiBlock = (uint8_t) uiValue;
+          g_tState.bBlock  = true;
+        }
+        else
+        {
+          fprintf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-w")) || (0 == stricmp(acArg, "--watch")))
+      {
+        if ((i + 1) < argc)
+        {
+          g_tState.tWatch.uiFrames = (uint8_t) constrain(strtoul(argv[++i], 0, 0), 1, 0xFF);
+        }
+        else
+        {
+          fprintf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-g")) || (0 == stricmp(acArg, "--log")))
+      {
+        if ((i + 1) < argc)
+        {
+          g_tState.uiLog = (uint8_t) constrain(strtoul(argv[++i], 0, 0), 1, 0xFF);
+        }
+        else
+        {
+          fprintf(stderr, "option %s requires a value\n", acArg);
+          iReturn = EINVAL;
+          break;
+        }
+      }
+      else if ((0 == strcmp(acArg, "-m")) || (0 == stricmp(acArg, "--memory")))
+      {
+        g_tState.bCapture = true;
+      }
+      else if ((0 == strcmp(acArg, "-u")) || (0 == stricmp(acArg, "--unload")))
       {
-        if (DUMP_NONE == g_tState.eMode)
+        if ((i + 1) < argc)
         {
-          g_tState.eMode = DUMP_LOGICAL;
+          /* First 8K bank of the capture, no silent wrap around */
+          unsigned long uiValue = strtoul(argv[++i], 0, 0);
+
+          if (uiCAPTURE_BANKS <= uiValue)
+          {
+            fprintf(stderr, "option %s requires a value (max. %u)\n", acArg, uiCAPTURE_BANKS - 1);
+            iReturn = EINVAL;
+            break;
+          }
+
+          g_tState.uiCapture = (uint8_t) uiValue;
+          g_tState.eAction   = ACTION_UNLOAD;
         }
         else
         {
-          fprintf(stderr, "options -l/-p/-f are mutually exclusive\n");
+          fprintf(stderr, "option %s requires a value\n", acArg);
           iReturn = EINVAL;
           break;
         }
       }
+      else if ((0 == strcmp(acArg, "-l")) || (0 == stricmp(acArg, "--logical")))
+      {
+        g_tState.eMode = DUMP_LOGICAL;
+        ++uiSources;
+      }
       else if ((0 == strcmp(acArg, "-p")) || (0 == stricmp(acArg, "--physical")))
       {
-        if (DUMP_NONE == g_tState.eMode)
+        g_tState.eMode = DUMP_PHYSICAL;
+        ++uiSources;
+      }
+      else if ((0 == strcmp(acArg, "-n")) || (0 == stricmp(acArg, "--nextreg")))
+      {
+        g_tState.eMode = DUMP_NEXTREG;
+        ++uiSources;
+      }
+      else if ((0 == strcmp(acArg, "-c")) || (0 == stricmp(acArg, "--colors")))
+      {
+        g_tState.eMode = DUMP_PALETTE;
+        ++uiSources;
+      }
+      else if ((0 == strcmp(acArg, "-t")) || (0 == stricmp(acArg, "--tilemap")))
+      {
+        g_tState.eMode = DUMP_TILEMAP;
+        ++uiSources;
+      }
+      else if ((0 == strcmp(acArg, "-d")) || (0 == stricmp(acArg, "--disk")))
+      {
+        if ((i + 1) < argc)
         {
-          g_tState.eMode = DUMP_PHYSICAL;
+          g_tState.tRdFile.uiDevice = (uint8_t) strtoul(argv[++i], 0, 0);
+          g_tState.eMode = DUMP_DISK;
+          ++uiSources;
         }
         else
         {
-          fprintf(stderr, "options -l/-p/-f are mutually exclusive\n");
+          fprintf(stderr, "option %s requires a value\n", acArg);
           iReturn = EINVAL;
           break;
         }
       }
       else if ((0 == strcmp(acArg, "-f")) || (0 == stricmp(acArg, "--file")))
       {
-        if (DUMP_NONE == g_tState.eMode)
+        if ('\0' == g_tState.tRdFile.acPathName[0])
         {
           if ((i + 1) < argc)
           {
             snprintf(g_tState.tRdFile.acPathName, sizeof(g_tState.tRdFile.acPathName), "%s", argv[++i]);
             zxn_normalizepath(g_tState.tRdFile.acPathName);
             g_tState.eMode = DUMP_FILE;
+            ++uiSources;
           }
           else
           {
@@ -334,7 +764,7 @@ int parseArguments(int argc, char* argv[])
         }
         else
         {
-          fprintf(stderr, "options -l/-p/-f are mutually exclusive\n");
+          fprintf(stderr, "only one input file supported\n");
           iReturn = EINVAL;
           break;
         }
@@ -344,6 +774,23 @@ int parseArguments(int argc, char* argv[])
         if ((i + 1) < argc)
         {
           g_tState.uiOffset = strtoul(argv[++i], 0, 0);
+
+          /* -o and -s describe one region in any order */
+          if ((0 != g_tState.uiRegions) && !bOffset)
+          {
+            g_tState.tRegion[g_tState.uiRegions - 1].uiOffset = g_tState.uiOffset;
+          }
+          else if (EOK != (iReturn = addRegion(g_tState.eMode, g_tState.uiOffset)))
+          {
+            fprintf(stderr, "too many regions (max. %u)\n", uiMAX_REGIONS);
+            break;
+          }
+          else
+          {
+            bSize = false;
+          }
+
+          bOffset = true;
         }
         else
         {
@@ -357,6 +804,20 @@ int parseArguments(int argc, char* argv[])
         if ((i + 1) < argc)
         {
           g_tState.uiSize = strtoul(argv[++i], 0, 0);
+
+          if ((0 == g_tState.uiRegions) || bSize)
+          {
+            if (EOK != (iReturn = addRegion(g_tState.eMode, g_tState.uiOffset)))
+            {
+              fprintf(stderr, "too many regions (max. %u)\n", uiMAX_REGIONS);
+              break;
+            }
+
+            bOffset = false;
+          }
+
+          g_tState.tRegion[g_tState.uiRegions - 1].uiSize = g_tState.uiSize;
+          bSize = true;
         }
         else
         {
@@ -406,6 +867,22 @@ int parseArguments(int argc, char* argv[])
     {
       g_tState.eAction = ACTION_DUMP;
     }
+
+    /* Without option -o/-s there is one region at the last offset; its size
+       stays 0, only a tape block (-j) sets it to the size of the block */
+    if (0 == g_tState.uiRegions)
+    {
+      (void) addRegion(g_tState.eMode, g_tState.uiOffset);
+    }
+
+    /* Regions without datasource use the last datasource given */
+    for (uint8_t j = 0; j < g_tState.uiRegions; ++j)
+    {
+      if (DUMP_NONE == g_tState.tRegion[j].eMode)
+      {
+        g_tState.tRegion[j].eMode = g_tState.eMode;
+      }
+    }
   }
 
   /* Plausibility checks */
@@ -418,26 +895,76 @@ int parseArguments(int argc, char* argv[])
         fprintf(stderr, "no dump mode specified\n");
         iReturn = EDOM;
       }
-#if 0
-      else if (!g_tState.bQuiet && ('\0' != g_tState.tWrFile.acPathName[0]))
+      else if (uiSources > g_tState.uiRegions)
       {
-        fprintf(stderr, "no dump to file in interactive mode\n");
+        fprintf(stderr, "options -l/-p/-f are mutually exclusive\n");
         iReturn = EDOM;
       }
-#endif
-      else if (g_tState.bQuiet && ('\0' == g_tState.tWrFile.acPathName[0]))
+      else if ((1 < g_tState.uiRegions) && ('\0' == g_tState.tWrFile.acPathName[0]) && !g_tState.bCapture)
       {
-        fprintf(stderr, "output file required in quiet mode\n");
+        fprintf(stderr, "multiple regions require output file\n");
         iReturn = EDOM;
       }
-    }
-  }
-
-  return iReturn;
-}
-
-
-/*----------------------------------------------------------------------------*/
+      else if (g_tState.bArchive && (g_tState.bHex || (('\0' == g_tState.tWrFile.acPathName[0]) && !g_tState.bCapture)))
+      {
+        fprintf(stderr, "archive requires raw output file\n");
+        iReturn = EDOM;
+      }
+      else if (g_tState.bIndex && ((DUMP_FILE != g_tState.eMode) || (1 < g_tState.uiRegions)))
+      {
+        fprintf(stderr, "option -i requires option -f\n");
+        iReturn = EDOM;
+      }
+      else if (g_tState.bBank && ((DUMP_FILE != g_tState.eMode) || (1 < g_tState.uiRegions) || g_tState.bIndex))
+      {
+        fprintf(stderr, "option -k requires option -f\n");
+        iReturn = EDOM;
+      }
+      else if (g_tState.bBlock && ((DUMP_FILE != g_tState.eMode) || (1 < g_tState.uiRegions) || g_tState.bIndex || g_tState.bBank))
+      {
+        fprintf(stderr, "option -j requires option -f\n");
+        iReturn = EDOM;
+      }
+      else if ((0 != g_tState.uiLog) && ((1 < g_tState.uiRegions) || g_tState.bArchive || g_tState.bHex ||
+                                          (DUMP_FILE == g_tState.eMode) || (DUMP_DISK == g_tState.eMode) ||
+                                          ('\0' == g_tState.tWrFile.acPathName[0])))
+      {
+        fprintf(stderr, "option -g requires one memory region and output file\n");
+        iReturn = EDOM;
+      }
+      else if (g_tState.bCapture && (g_tState.bHex || (0 != g_tState.uiLog)))
+      {
+        fprintf(stderr, "option -m requires raw output\n");
+        iReturn = EDOM;
+      }
+#if 0
+      else if (!g_tState.bQuiet && ('\0' != g_tState.tWrFile.acPathName[0]))
+      {
+        fprintf(stderr, "no dump to file in interactive mode\n");
+        iReturn = EDOM;
+      }
+#endif
+      else if (g_tState.bQuiet && ('\0' == g_tState.tWrFile.acPathName[0]) && !g_tState.bCapture)
+      {
+        fprintf(stderr, "output file required in quiet mode\n");
+        iReturn = EDOM;
+      }
+    }
+    else if (ACTION_UNLOAD == g_tState.eAction)
+    {
+      if ('\0' == g_tState.tWrFile.acPathName[0])
+      {
+        fprintf(stderr, "option -u requires output file\n");
+        iReturn = EDOM;
+      }
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
 /* showHelp()                                                                 */
 /*----------------------------------------------------------------------------*/
 int showHelp(void)
@@ -448,18 +975,34 @@ int showHelp(void)
 
   printf("%s\n\n", VER_FILEDESCRIPTION_STR);
 
-  printf("%s [-f ifile][-l][-p][-o offset][-s size][-r][-x][-q][-h][-v] ofile\n\n", acAppName);
+  printf("%s [-f ifile][-l][-p][-n][-c][-t][-d dev][-o offset][-s size][-b list][-a][-i index][-k bank][-j block][-w frames][-g frames][-m][-u bank][-r][-x][-q][-z][-e fmt][-h][-v] ofile\n\n", acAppName);
   //      0.........1.........2.........3.
   printf("  ofile      pathname out-file\n");
   printf(" -f[ile]     read from file\n");
   printf("  ifile      pathname in-file\n");
   printf(" -l[ogical]  read logical mem.\n");
   printf(" -p[hysical] read physical mem.\n");
+  printf(" -n[extreg]  read next registers\n");
+  printf(" -c[olors]   read palettes\n");
+  printf(" -t[ilemap]  read tilemap\n");
+  printf(" -d[isk]     read disk sectors\n");
+  printf("  dev        esxDOS device\n");
   printf(" -o[ffset]   offset to read from\n");
   printf(" -s[ize]     length to read\n");
+  printf(" -b[atch]    regions from list\n");
+  printf(" -a[rchive]  regions to archive\n");
+  printf(" -i[ndex]    region of archive\n");
+  printf(" -[ban]k     bank of snapshot\n");
+  printf(" -j[ump]     block of tape\n");
+  printf(" -w[atch]    refresh n frames\n");
+  printf(" -[lo]g      change-log n frames\n");
+  printf(" -m[emory]   capture to RAM\n");
+  printf(" -u[nload]   save capture of bank\n");
   printf(" -[fo]r[ce]  force overwrite\n");
   printf(" -[he]x      file dump in hex\n");
   printf(" -q[uiet]    no screen output\n");
+  printf(" -[squee]z   skip repeats\n");
+  printf(" -e fmt      line format\n");
   printf(" -h[elp]     print this help\n");
   printf(" -v[ersion]  print version info\n");
 
@@ -468,6 +1011,24 @@ int showHelp(void)
   bindump -l -o 0x0000 -s 0x4000 -q c:/home/tmp/dump.bin
   bindump -f c:/dot/ls -o 0x0000 -s 0x10000 -q c:/home/tmp/dump.bin
   bindump -p -o 0x21000 -s 0x100 -q -r c:/home/tmp/dump.bin
+  bindump -a -p -o 0x20000 -s 0x2000 -o 0x40000 -s 0x2000 -l -o 0xC000 -s 0x100 -q c:/home/tmp
+  bindump -f c:/home/tmp/bindump-0.bda -i 1 -o 0x0000 -s 0x100
+  bindump -p -o 0x20000 -s 0x100 -o 0x40000 -s 0x100 -b c:/home/tmp/ranges.txt -q c:/home/tmp
+  bindump -n -o 0x00 -s 0x100
+  bindump -c -o 0x0000 -s 0x1000 -q c:/home/tmp/palette.bin
+  bindump -t -o 0x0000 -s 0xA00
+  bindump -d 0x80 -o 0x0000 -s 0x200
+  bindump -f c:/dot/game.nex -k 5 -o 0x1800 -s 0x300
+  bindump -f c:/home/tmp/game.tzx -j 40
+  bindump -l -o 0x5C00 -s 0x100 -w 1
+  bindump -l -o 0x5C00 -s 0x800 -g 1 -q c:/home/tmp/vars.bdl
+  bindump -m -p -o 0x20000 -s 0x4000 -o 0x40000 -s 0x4000 -a
+  bindump -u 0x5A c:/home/tmp
+  bindump -f c:/home/tmp/dump.lzs -o 0x8000 -s 0x100
+  bindump -p -o 0x40000 -s 0x4000 -z
+  bindump -l -o 0x4000 -s 0x100 -e "%a: %4x"
+  bindump -n -o 0x00 -s 0x100 -e "%a %b"
+  bindump -f c:/home/tmp/samples.raw -e "%a %hd"
   */
 
   return EOK;
@@ -533,158 +1094,225 @@ int dump(void)
   /* Open input file */
   if (EOK == iReturn)
   {
-    if (DUMP_FILE == g_tState.eMode)
+    if ('\0' != g_tState.tRdFile.acPathName[0])
     {
-      if ('\0' != g_tState.tRdFile.acPathName[0])
+      g_tState.tRdFile.uiBase = 0;
+
+      if (EOK != (iReturn = openFile(&g_tState.tRdFile)))
+      {
+        fprintf(stderr, "dumpData() - esx_f_open(%s) = %u\n", g_tState.tRdFile.acPathName, g_tState.tRdFile.hFile);
+      }
+
+      /* Compressed file: the datasource delivers the decoded data */
+      if (EOK == iReturn)
+      {
+        g_tState.tRdFile.bPacked = (EOK == unpackOpen(&g_tState.tRdFile));
+
+        if (g_tState.tRdFile.bPacked && (g_tState.bIndex || g_tState.bBank || g_tState.bBlock))
+        {
+          fprintf(stderr, "options -i/-k/-j not supported for compressed files\n");
+          iReturn = ENOTSUP;
+        }
+      }
+
+      if ((EOK == iReturn) && g_tState.bIndex) /* Region of an archive file */
+      {
+        archiveentry_t tEntry;
+        region_t* pRegion = &g_tState.tRegion[0];
+
+        if (EOK == (iReturn = archiveSelect(g_tState.uiIndex, &tEntry, &g_tState.tRdFile)))
+        {
+          clipRegion(&pRegion->uiOffset, &pRegion->uiSize, tEntry.uiSize);
+
+          /* Show the addresses of the region in it's original datasource */
+          pRegion->uiOffset += tEntry.uiOffset;
+          g_tState.tRdFile.uiBase = tEntry.uiData - tEntry.uiOffset;
+        }
+        else
+        {
+          fprintf(stderr, "dumpData() - archiveSelect(%u) = %d\n", g_tState.uiIndex, iReturn);
+        }
+      }
+
+      if ((EOK == iReturn) && g_tState.bBank) /* Bank of a snapshot file */
       {
-        uint8_t uiResult = 0;
-        struct esx_stat tStat;
-        memset(&tStat, 0, sizeof(tStat));
+        uint32_t  uiPos   = 0;
+        region_t* pRegion = &g_tState.tRegion[0];
 
-        if (0 == (uiResult = esx_f_stat(g_tState.tRdFile.acPathName, &tStat)))
+        if (EOK == (iReturn = snapshotIndex(&g_tState.tRdFile)))
         {
-          if ((g_tState.uiOffset + g_tState.uiSize) > tStat.size)
+          iReturn = snapshotBank(g_tState.uiBank, &uiPos);
+        }
+
+        if (EOK == iReturn)
+        {
+          clipRegion(&pRegion->uiOffset, &pRegion->uiSize, uiSNAP_BANK_SIZE);
+          g_tState.tRdFile.uiBase = uiPos;
+        }
+        else
+        {
+          fprintf(stderr, "dumpData() - snapshotBank(%u) = %d\n", g_tState.uiBank, iReturn);
+        }
+      }
+
+      /* Tape image: index of the blocks for -j and the interactive mode */
+      if ((EOK == iReturn) && !g_tState.bIndex && !g_tState.bBank && !g_tState.tRdFile.bPacked)
+      {
+        g_tState.bTape = (EOK == tapeIndex(&g_tState.tRdFile));
+
+        if (g_tState.bBlock) /* Block of a tape image */
+        {
+          uint32_t  uiPos   = 0;
+          uint32_t  uiSize  = 0;
+          region_t* pRegion = &g_tState.tRegion[0];
+
+          if (!g_tState.bTape)
           {
-            if (g_tState.uiOffset < tStat.size)
-            {
-              g_tState.uiSize = tStat.size - g_tState.uiOffset;
-            }
-            else
+            iReturn = ENOTSUP;
+          }
+          else if (EOK == (iReturn = tapeBlock(g_tState.uiBlock, &uiPos, &uiSize, 0)))
+          {
+            if (0 == pRegion->uiSize)
             {
-              g_tState.uiOffset = 0;
-              g_tState.uiSize   = tStat.size;
+              pRegion->uiSize = uiSize;
             }
+
+            clipRegion(&pRegion->uiOffset, &pRegion->uiSize, uiSize);
+            pRegion->uiOffset += uiPos;
           }
 
-          if (INV_FILE_HND == (g_tState.tRdFile.hFile = esx_f_open(g_tState.tRdFile.acPathName, ESX_MODE_READ | ESX_MODE_OPEN_EXIST)))
+          if (EOK != iReturn)
           {
-            fprintf(stderr, "dumpData() - esx_f_open(%s) = %u\n", g_tState.tRdFile.acPathName, g_tState.tRdFile.hFile);
-            iReturn = EBADF;
+            fprintf(stderr, "dumpData() - tapeBlock(%u) = %d\n", g_tState.uiBlock, iReturn);
           }
         }
-        else
-        {
-          fprintf(stderr, "dumpData() - esx_f_stat(%s) = %u\n", g_tState.tRdFile.acPathName, uiResult);
-          iReturn = EBADF;
-        }
       }
     }
   }
 
-  /* Calculate bounds of the region to read */
-  if (EOK == iReturn)
+  /* Walk through the datasources in address order (an archive keeps the
+     order of the command line, "-i n" selects the n-th region of its table) */
+  if ((EOK == iReturn) && !g_tState.bArchive)
   {
-    uint32_t uiStrideMask = ~(((uint32_t) g_tState.tRead.uiStride) - UINT32_C(1));
+    sortRegions();
+  }
 
-    g_tState.tRead.uiLower = g_tState.uiOffset;
-    g_tState.tRead.uiUpper = g_tState.uiOffset + g_tState.uiSize;
-    g_tState.tRead.uiBegin = g_tState.tRead.uiLower & uiStrideMask;
-    g_tState.tRead.uiAddr  = g_tState.tRead.uiBegin;
-    g_tState.tRead.uiEnd   = (g_tState.tRead.uiUpper + (g_tState.tRead.uiStride - 1)) & uiStrideMask;
+  /* Limit the regions to the size of their datasource */
+  if ((EOK == iReturn) && !g_tState.bIndex && !g_tState.bBank)
+  {
+    for (uint8_t i = 0; (EOK == iReturn) && (i < g_tState.uiRegions); ++i)
+    {
+      region_t* pRegion = &g_tState.tRegion[i];
 
-    DBGPRINTF("dump() - stride = 0x%02X\n", g_tState.tRead.uiStride);
-    DBGPRINTF("dump() - outer  = 0x%06lX-0x%06lX\n", g_tState.tRead.uiBegin, g_tState.tRead.uiEnd);
-    DBGPRINTF("dump() - inner  = 0x%06lX-0x%06lX\n", g_tState.tRead.uiLower, g_tState.tRead.uiUpper);
+      if (EOK == (iReturn = selectSource(pRegion->eMode)))
+      {
+        clipRegion(&pRegion->uiOffset, &pRegion->uiSize, sourceSize(&g_tState.tSource));
+      }
+      else
+      {
+        fprintf(stderr, "dumpData() - sourceOpen(%u) = %d\n", pRegion->eMode, iReturn);
+      }
+    }
   }
 
-  /* Open output file */
+  /* Is the output argument a directory ? */
   if (EOK == iReturn)
   {
+    g_tState.bOutDir = false;
+    g_tState.uiOutIdx = 0;
+
     if ('\0' != g_tState.tWrFile.acPathName[0])
     {
-      if (EOK == iReturn)
+      scanOutputDir();
+    }
+  }
+
+  /* Execute the dump */
+  if (EOK == iReturn)
+  {
+    if (g_tState.bArchive)
+    {
+      if (EOK == (iReturn = openOutput()))
+      {
+        iReturn = dumpArchive();
+      }
+    }
+    else if (g_tState.bCapture)
+    {
+      iReturn = dumpCapture();
+    }
+    else if (0 != g_tState.uiLog)
+    {
+      if (EOK == (iReturn = selectSource(g_tState.tRegion[0].eMode)))
       {
-        /* Is argument a directory ? */
-        if (INV_FILE_HND != (g_tState.tWrFile.hFile = esx_f_opendir(g_tState.tWrFile.acPathName)))
+        if (EOK == (iReturn = openOutput()))
         {
-          uint16_t uiIdx = 0;
-          char_t acPathName[ESX_PATHNAME_MAX];
+          iReturn = dumpLog();
+        }
+      }
+    }
+    else
+    {
+      for (uint8_t i = 0; (EOK == iReturn) && (i < g_tState.uiRegions); ++i)
+      {
+        g_tState.eMode = g_tState.tRegion[i].eMode;
 
-          esx_f_closedir(g_tState.tWrFile.hFile);
-          g_tState.tWrFile.hFile = INV_FILE_HND;
+        if (EOK != (iReturn = selectSource(g_tState.eMode)))
+        {
+          break;
+        }
 
-          while (uiIdx < 0xFFFF)
-          {
-            snprintf(acPathName, sizeof(acPathName),
-                      "%s" ESX_DIR_SEP VER_INTERNALNAME_STR "-%u.%s",
-                      g_tState.tWrFile.acPathName,
-                      uiIdx,
-                      g_tState.bHex ? "txt" : "bin");
+        setBounds(g_tState.tRegion[i].uiOffset, g_tState.tRegion[i].uiSize);
 
-            if (INV_FILE_HND == (g_tState.tWrFile.hFile = esx_f_open(acPathName, ESXDOS_MODE_R | ESXDOS_MODE_OE)))
-            {
-              snprintf(g_tState.tWrFile.acPathName, sizeof(g_tState.tWrFile.acPathName), "%s", acPathName);
-              break;  /* filename found */
-            }
-            else
-            {
-              esx_f_close(g_tState.tWrFile.hFile);
-              g_tState.tWrFile.hFile = INV_FILE_HND;
-            }
+        if (EOK != (iReturn = renderSetup(&g_tState.tScreen, &g_tState.tRead, &g_tState.tRender)))
+        {
+          fprintf(stderr, "format too long for the line\n");
+          break;
+        }
 
-            ++uiIdx;
+        if ('\0' != g_tState.tWrFile.acPathName[0])
+        {
+          /* A directory gets one file per region, a file gets all regions */
+          if (INV_FILE_HND == g_tState.tWrFile.hFile)
+          {
+            iReturn = openOutput();
           }
 
-          if (0xFFFF == uiIdx)
+          if (EOK == iReturn)
           {
-            iReturn = ERANGE; /* Error */
+            iReturn = dumpPassive();
+          }
+
+          if ((EOK == iReturn) && g_tState.bOutDir)
+          {
+            iReturn = saveFlush(&g_tState.tWrFile);
           }
-        }
-        else /* Argument is a file ... */
-        {
-          g_tState.tWrFile.hFile = esx_f_open(g_tState.tWrFile.acPathName, ESXDOS_MODE_R | ESXDOS_MODE_OE);
 
-          if (INV_FILE_HND != g_tState.tWrFile.hFile)
+          if ((EOK == iReturn) && g_tState.bOutDir)
           {
             esx_f_close(g_tState.tWrFile.hFile);
             g_tState.tWrFile.hFile = INV_FILE_HND;
-
-            if (g_tState.bForce)
-            {
-              esx_f_unlink(g_tState.tWrFile.acPathName);
-            }
-            else
-            {
-              iReturn = EBADF; /* Error: File exists */
-            }
           }
         }
-      }
-
-      if (EOK == iReturn)
-      {
-        g_tState.tWrFile.hFile = esx_f_open(g_tState.tWrFile.acPathName, ESXDOS_MODE_W | ESXDOS_MODE_CN);
-
-        if (INV_FILE_HND == g_tState.tWrFile.hFile)
+        else
         {
-          iReturn = EACCES; /* Error */
+          iReturn = dumpInteractive();
         }
       }
     }
   }
 
-  /* Execute the dump */
-  if (EOK == iReturn)
-  {
-    if (INV_FILE_HND != g_tState.tWrFile.hFile)
-    {
-      iReturn = dumpPassive();
-    }
-    else
-    {
-      iReturn = dumpInteractive();
-    }
-  }
-
   /* Close open files */
-  if (INV_FILE_HND != g_tState.tRdFile.hFile)
-  {
-    esx_f_close(g_tState.tRdFile.hFile);
-    g_tState.tRdFile.hFile = INV_FILE_HND;
-  }
+  sourceClose(&g_tState.tSource);
+  closeFile(&g_tState.tRdFile);
 
   if (INV_FILE_HND != g_tState.tWrFile.hFile)
   {
+    if (EOK == iReturn)
+    {
+      iReturn = saveFlush(&g_tState.tWrFile);
+    }
+
     esx_f_close(g_tState.tWrFile.hFile);
     g_tState.tWrFile.hFile = INV_FILE_HND;
 
@@ -712,25 +1340,93 @@ int dumpPassive(void)
     // ioctl(1, OTERM_MSG_SCROLL_LIMIT, (void*) 0);
     // ioctl(fileno(stdout), IOCTL_OTERM_PAUSE, 0);
 
+    /* Nothing to show or to format: copy the region in blocks */
+    if (g_tState.bQuiet && !g_tState.bHex && (INV_FILE_HND != g_tState.tWrFile.hFile))
+    {
+      iReturn = dumpRaw();
+    }
+
+    bool bRaw    = (INV_FILE_HND != g_tState.tWrFile.hFile) && !g_tState.bHex;
+    bool bLast   = false; /* uiLast holds the last line shown */
+    bool bRepeat = false; /* "*" is shown for the repeats of the last line */
+    uint8_t uiLast[uiMAX_STRIDE];
+
     /* Walk through the region */
     while (g_tState.tRead.uiAddr < g_tState.tRead.uiEnd)
     {
-      if (EOK == (iResult = readFrame(g_tState.eMode, &g_tState.tRdFile , &g_tState.tRead)))
+      if (EOK == (iResult = readFrame(&g_tState.tSource, &g_tState.tRead)))
       {
-        if (!g_tState.bQuiet || g_tState.bHex)
+        uint16_t uiSkip = 0;
+        bool     bSame  = false;
+
+        /* The DMA reads the next block while this one is formatted */
+        (void) sourcePrefetch(&g_tState.tSource, &g_tState.tRead);
+
+        if (g_tState.bSqueeze)
         {
-          renderFrame(&g_tState.tScreen, &g_tState.tRead, &g_tState.tRender);
+          bSame = bLast && (g_tState.tRead.uiStride == zxn_mismatch(uiLast, g_tState.tRead.uiData, g_tState.tRead.uiStride));
         }
 
-        if (!g_tState.bQuiet)
+        if (bSame)
+        {
+          if (!bRepeat)
+          {
+            if (!g_tState.bQuiet)
+            {
+              printf("*\n");
+            }
+
+            if ((INV_FILE_HND != g_tState.tWrFile.hFile) && g_tState.bHex)
+            {
+              /* Saving maps the write buffer into MMU6 */
+              if (g_tState.tSource.bFetchMmu)
+              {
+                sourceWait(&g_tState.tSource);
+              }
+
+              saveBlock((const uint8_t*) "*\n", 2, &g_tState.tWrFile);
+            }
+
+            bRepeat = true;
+          }
+
+          /* Without raw output the rest of the block can be skipped at once */
+          if (!bRaw)
+          {
+            uiSkip = squeezeFrames(uiLast);
+          }
+        }
+        else
         {
-          printf("%s%s",
-                 g_tState.tRender.acData,
-                 (g_tState.tScreen.uiCols != g_tState.tRender.uiLen ? "\n" : ""));
+          if (g_tState.bSqueeze)
+          {
+            zxn_ldi(uiLast, g_tState.tRead.uiData, g_tState.tRead.uiStride);
+            bLast   = true;
+            bRepeat = false;
+          }
+
+          if (!g_tState.bQuiet || g_tState.bHex)
+          {
+            renderFrame(&g_tState.tScreen, &g_tState.tRead, &g_tState.tRender);
+          }
+
+          if (!g_tState.bQuiet)
+          {
+            printf("%s%s",
+                   g_tState.tRender.acData,
+                   (g_tState.tScreen.uiCols != g_tState.tRender.uiLen ? "\n" : ""));
+          }
         }
 
-        if (INV_FILE_HND != g_tState.tWrFile.hFile)
+        if ((INV_FILE_HND != g_tState.tWrFile.hFile) && (bRaw || !bSame))
         {
+          /* Saving maps the write buffer into MMU6, which is the source of
+             the fetch of a physical page; the copy itself is done by the CPU */
+          if (g_tState.tSource.bFetchMmu)
+          {
+            sourceWait(&g_tState.tSource);
+          }
+
           if (g_tState.bHex)
           {
 #if 0
@@ -745,13 +1441,15 @@ int dumpPassive(void)
           }
         }
 
-        g_tState.tRead.uiAddr += g_tState.tRead.uiStride;
+        zxn_add32(&g_tState.tRead.uiAddr, uiSkip + g_tState.tRead.uiStride);
       }
       else
       {
         break;
       }
     }
+
+    sourceWait(&g_tState.tSource);
   }
 
   return iReturn;
@@ -770,15 +1468,28 @@ int dumpInteractive(void)
     int  iResult = EOK;
     bool bQuit   = false;
     bool bUpdate = true;
+    bool bConfirm = false;
     int  iKey;
     uint32_t uiAddr = g_tState.tRead.uiAddr;
 
+    g_tState.tCursor.bEdit   = false;
+    g_tState.tCursor.bNibble = false;
+
+    /* Without marks the whole region is selected */
+    g_tState.tCursor.uiMark[0] = g_tState.tRead.uiLower;
+    g_tState.tCursor.uiMark[1] = g_tState.tRead.uiUpper - 1;
+
     do
     {
       if (bUpdate)
       {
         g_tState.tRead.uiAddr = uiAddr;
 
+        if (0 != g_tState.tWatch.uiFrames)
+        {
+          sourceFlush(&g_tState.tSource);
+        }
+
         if (32 < g_tState.tScreen.uiCols)
         {
           tshr_cls(INK_YELLOW | PAPER_BLUE);
@@ -791,13 +1502,24 @@ int dumpInteractive(void)
 
         for (uint8_t i = 0; i < g_tState.tScreen.uiRows - 1; ++i)
         {
-          if (EOK == (iResult = readFrame(g_tState.eMode, &g_tState.tRdFile , &g_tState.tRead)))
+          if (EOK == (iResult = readFrame(&g_tState.tSource, &g_tState.tRead)))
           {
+            editApply(&g_tState.tRead);
+
             if (EOK == (iResult = renderFrame(&g_tState.tScreen, &g_tState.tRead, &g_tState.tRender)))
             {
               // printf("%c%c%c", 0x16, i, 0);
               zxn_gotoxy(0, i); 
               printf("%s", g_tState.tRender.acData);
+
+              /* The decode panel uses the columns right of the line */
+              if (0 == i)
+              {
+                g_tState.tCursor.uiPanelCol = ((g_tState.tRender.uiLen + uiDECODE_COLS) <= g_tState.tScreen.uiCols ? g_tState.tRender.uiLen : 0);
+              }
+
+              zxn_ldi(g_tState.tWatch.uiData[i], g_tState.tRead.uiData, g_tState.tRead.uiStride);
+              g_tState.tWatch.uiMarked[i] = 0;
             }
             else
             {
@@ -816,11 +1538,57 @@ int dumpInteractive(void)
           g_tState.tRead.uiAddr += ((uint32_t) g_tState.tRead.uiStride);
         }
 
+        if (!bQuit)
+        {
+          drawCell(uiAddr, g_tState.tCursor.uiIdx, true);
+          drawPanel(uiAddr, true);
+
+          if (g_tState.tCursor.bEdit)
+          {
+            showStatus("edit (0-9, a-f)");
+          }
+        }
+
         bUpdate = false;
+        g_tState.tWatch.uiTick = g_tState.tWatch.uiFrames;
+      }
+
+      /* Watch mode: sample the visible window every n frames */
+      if ((0 != g_tState.tWatch.uiFrames) && !bQuit)
+      {
+        intrinsic_halt();
+
+        if (0 == --g_tState.tWatch.uiTick)
+        {
+          g_tState.tWatch.uiTick = g_tState.tWatch.uiFrames;
+
+          if (EOK != (iResult = watchSample(uiAddr)))
+          {
+            iReturn = iResult;
+            bQuit = true;
+          }
+          else if (g_tState.tCursor.bDirty)
+          {
+            drawPanel(uiAddr, false);
+          }
+        }
       }
 
       if (0 != (iKey = in_inkey()))
       {
+        /* Edit mode: hex digits modify the byte under the cursor */
+        if (g_tState.tCursor.bEdit && isxdigit(iKey))
+        {
+          bUpdate = editCursor(&uiAddr, iKey);
+          iKey    = 0;
+        }
+
+        /* Any other key cancels the confirmation of the quit */
+        if (('q' != iKey) && ('Q' != iKey) && (' ' != iKey))
+        {
+          bConfirm = false;
+        }
+
         switch (iKey)
         {
           case 8: // CAPS + 5 = LEFT
@@ -855,18 +1623,1166 @@ int dumpInteractive(void)
             }
             break;
 
-          case 'q':
-          case 'Q':
-          case ' ':
-            bQuit = true;
+          case 'h': // cursor left
+          case 'l': // cursor right
+          case 'k': // cursor up
+          case 'j': // cursor down
+            g_tState.tCursor.bNibble = false;
+            bUpdate = moveCursor(&uiAddr, iKey);
             break;
-        }
-      }
-    }
-    while (!bQuit);
-  }
 
-  return iReturn;
+          case 'i': // edit mode on/off
+            if (g_tState.tCursor.bEdit)
+            {
+              g_tState.tCursor.bEdit = false;
+              showStatus(0 != editCount() ? "view (W = save, U = undo)" : "view");
+            }
+            else if (!sourceWritable(&g_tState.tSource))
+            {
+              showStatus("source is read-only");
+            }
+            else if (EOK != (iResult = editOpen()))
+            {
+              showStatus(zxn_strerror(iResult));
+            }
+            else
+            {
+              g_tState.tCursor.bEdit   = true;
+              g_tState.tCursor.bNibble = false;
+              showStatus("edit (0-9, a-f)");
+            }
+            break;
+
+          case 'W': // write the modifications back to the datasource
+            if (0 != editCount())
+            {
+              iResult = editSave(&g_tState.tSource);
+              showStatus(EOK == iResult ? "saved" : zxn_strerror(iResult));
+            }
+            break;
+
+          case 'U': // discard the modifications
+            if (0 != editCount())
+            {
+              editDiscard();
+              sourceFlush(&g_tState.tSource);
+              bUpdate = true;
+            }
+            break;
+
+          case 's': // mark the start of the selection
+          case 'e': // mark the end of the selection
+          {
+            char_t acText[40];
+
+            g_tState.tCursor.uiMark['e' == iKey ? 1 : 0] = uiAddr + g_tState.tCursor.uiIdx;
+
+            snprintf(acText, sizeof(acText), "mark 0x%06lX-0x%06lX",
+                     g_tState.tCursor.uiMark[0], g_tState.tCursor.uiMark[1]);
+            showStatus(acText);
+            break;
+          }
+
+          case 'w': // export the selection (raw)
+          case 'x': // export the selection (hex)
+          {
+            char_t acText[ESX_PATHNAME_MAX + 16];
+
+            if (EOK == (iResult = exportRange('x' == iKey)))
+            {
+              snprintf(acText, sizeof(acText), "saved %s", g_tState.tWrFile.acPathName);
+            }
+            else
+            {
+              snprintf(acText, sizeof(acText), "export: %s", zxn_strerror(iResult));
+            }
+
+            g_tState.tWrFile.acPathName[0] = '\0';
+            showStatus(acText);
+            break;
+          }
+
+          case 'n': // next block of a tape image
+          case 'N':
+          case 'b': // previous block of a tape image
+          case 'B':
+            if (g_tState.bTape)
+            {
+              uint32_t uiNext = jumpBlock(uiAddr, ('n' == iKey) || ('N' == iKey));
+
+              bUpdate = (uiNext != uiAddr);
+              uiAddr  = uiNext;
+            }
+            break;
+
+          case 'q':
+          case 'Q':
+          case ' ':
+            /* Unsaved modifications: the quit has to be confirmed */
+            if ((0 != editCount()) && !bConfirm)
+            {
+              showStatus("unsaved changes (W = save, U = undo)");
+              bConfirm = true;
+            }
+            else
+            {
+              bQuit = true;
+            }
+            break;
+        }
+      }
+    }
+    while (!bQuit);
+
+    /* Modifications, that are not saved, are discarded */
+    editClose();
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dumpArchive()                                                              */
+/*----------------------------------------------------------------------------*/
+int dumpArchive(void)
+{
+  int iReturn = EOK;
+
+  if (EOK == iReturn)
+  {
+    iReturn = archiveCreate(g_tState.tRegion, g_tState.uiRegions, &g_tState.tWrFile);
+  }
+
+  for (uint8_t i = 0; (EOK == iReturn) && (i < g_tState.uiRegions); ++i)
+  {
+    const region_t* pRegion = &g_tState.tRegion[i];
+
+    if (EOK == (iReturn = selectSource(pRegion->eMode)))
+    {
+      setBounds(pRegion->uiOffset, pRegion->uiSize);
+      iReturn = dumpRaw();
+    }
+
+    if ((EOK == iReturn) && !g_tState.bQuiet)
+    {
+      printf("%u: 0x%06lX-0x%06lX\n", i, g_tState.tRead.uiLower, g_tState.tRead.uiUpper);
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dumpLog()                                                                  */
+/*----------------------------------------------------------------------------*/
+int dumpLog(void)
+{
+  int iReturn = EOK;
+  int iResult = EOK;
+  uint32_t uiSamples = 0;
+
+  if (EOK != (iReturn = logOpen(&g_tState.tRegion[0], g_tState.uiLog, &g_tState.tWrFile)))
+  {
+    fprintf(stderr, "dumpLog() - logOpen() = %d\n", iReturn);
+  }
+
+  if (EOK == iReturn)
+  {
+    in_wait_nokey();
+
+    /* Sample every n frames until a key is pressed */
+    while ((EOK == iReturn) && (0 == in_inkey()))
+    {
+      if (EOK == (iReturn = logSample(&g_tState.tSource, &g_tState.tWrFile)))
+      {
+        ++uiSamples;
+
+        for (uint8_t i = 0; i < g_tState.uiLog; ++i)
+        {
+          intrinsic_halt();
+        }
+      }
+    }
+  }
+
+  if (EOK != (iResult = logClose(&g_tState.tWrFile)))
+  {
+    iReturn = (EOK == iReturn ? iResult : iReturn);
+  }
+
+  if ((EOK == iReturn) && !g_tState.bQuiet)
+  {
+    printf("0x%lX samples\n", uiSamples);
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dumpCapture()                                                              */
+/*----------------------------------------------------------------------------*/
+int dumpCapture(void)
+{
+  int iReturn = EOK;
+
+  if (EOK != (iReturn = captureOpen(g_tState.tRegion, g_tState.uiRegions, g_tState.bArchive)))
+  {
+    fprintf(stderr, "dumpCapture() - captureOpen() = %d\n", iReturn);
+  }
+
+  /* Copy all regions to RAM first; the SD card is accessed afterwards */
+  for (uint8_t i = 0; (EOK == iReturn) && (i < g_tState.uiRegions); ++i)
+  {
+    if (EOK == (iReturn = selectSource(g_tState.tRegion[i].eMode)))
+    {
+      iReturn = captureRegion(&g_tState.tSource, &g_tState.tRegion[i]);
+    }
+  }
+
+  if (EOK == iReturn)
+  {
+    if ('\0' != g_tState.tWrFile.acPathName[0])
+    {
+      if (EOK == (iReturn = openOutput()))
+      {
+        iReturn = captureFlush(&g_tState.tWrFile);
+      }
+
+      captureClose(false);
+    }
+    else
+    {
+      if (!g_tState.bQuiet)
+      {
+        printf("capture in bank %u\n", captureInfo()->uiPage[0]);
+      }
+
+      captureClose(true);
+    }
+  }
+  else
+  {
+    captureClose(false);
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* unloadCapture()                                                            */
+/*----------------------------------------------------------------------------*/
+int unloadCapture(void)
+{
+  int iReturn = EOK;
+
+  if (EOK != (iReturn = captureAttach(g_tState.uiCapture)))
+  {
+    fprintf(stderr, "unloadCapture() - captureAttach(%u) = %d\n", g_tState.uiCapture, iReturn);
+  }
+
+  if (EOK == iReturn)
+  {
+    g_tState.bArchive = captureInfo()->bArchive;
+    g_tState.bOutDir  = false;
+    g_tState.uiOutIdx = 0;
+
+    scanOutputDir();
+
+    if (EOK == (iReturn = openOutput()))
+    {
+      iReturn = captureFlush(&g_tState.tWrFile);
+    }
+
+    /* The banks are kept for another try, if the capture was not saved */
+    captureClose(EOK != iReturn);
+  }
+
+  if (INV_FILE_HND != g_tState.tWrFile.hFile)
+  {
+    esx_f_close(g_tState.tWrFile.hFile);
+    g_tState.tWrFile.hFile = INV_FILE_HND;
+
+    if (EOK != iReturn)
+    {
+      esx_f_unlink(g_tState.tWrFile.acPathName);
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* addRegion()                                                                */
+/*----------------------------------------------------------------------------*/
+static int addRegion(dumpmode_t eMode, uint32_t uiOffset)
+{
+  int iReturn = EOK;
+
+  if (uiMAX_REGIONS > g_tState.uiRegions)
+  {
+    region_t* pRegion = &g_tState.tRegion[g_tState.uiRegions++];
+
+    pRegion->eMode    = eMode;
+    pRegion->uiOffset = uiOffset;
+    pRegion->uiSize   = 0;
+  }
+  else
+  {
+    iReturn = ERANGE;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* clipRegion()                                                               */
+/*----------------------------------------------------------------------------*/
+static void clipRegion(uint32_t* pOffset, uint32_t* pSize, uint32_t uiLimit)
+{
+  if ((*pOffset + *pSize) > uiLimit)
+  {
+    if (*pOffset < uiLimit)
+    {
+      *pSize = uiLimit - *pOffset;
+    }
+    else
+    {
+      *pOffset = 0;
+      *pSize   = uiLimit;
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* setBounds()                                                                */
+/*----------------------------------------------------------------------------*/
+static void setBounds(uint32_t uiOffset, uint32_t uiSize)
+{
+  uint32_t uiStrideMask = ~(((uint32_t) g_tState.tRead.uiStride) - UINT32_C(1));
+
+  g_tState.tRead.uiLower = uiOffset;
+  g_tState.tRead.uiUpper = uiOffset + uiSize;
+  g_tState.tRead.uiBegin = g_tState.tRead.uiLower & uiStrideMask;
+  g_tState.tRead.uiAddr  = g_tState.tRead.uiBegin;
+  g_tState.tRead.uiEnd   = (g_tState.tRead.uiUpper + (g_tState.tRead.uiStride - 1)) & uiStrideMask;
+
+  DBGPRINTF("dump() - stride = 0x%02X\n", g_tState.tRead.uiStride);
+  DBGPRINTF("dump() - outer  = 0x%06lX-0x%06lX\n", g_tState.tRead.uiBegin, g_tState.tRead.uiEnd);
+  DBGPRINTF("dump() - inner  = 0x%06lX-0x%06lX\n", g_tState.tRead.uiLower, g_tState.tRead.uiUpper);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* openOutput()                                                               */
+/*----------------------------------------------------------------------------*/
+static int openOutput(void)
+{
+  int iReturn = EOK;
+
+  if (EOK == iReturn)
+  {
+    if (g_tState.bOutDir) /* Argument is a directory ... */
+    {
+      /* The index of the next unused filename is known from the scan */
+      if (0xFFFF > g_tState.uiOutIdx)
+      {
+        snprintf(g_tState.tWrFile.acPathName, sizeof(g_tState.tWrFile.acPathName),
+                  "%s" ESX_DIR_SEP VER_INTERNALNAME_STR "-%u.%s",
+                  g_tState.acOutDir,
+                  g_tState.uiOutIdx++,
+                  g_tState.bArchive ? acARCHIVE_EXT : (0 != g_tState.uiLog ? acLOG_EXT : (g_tState.bHex ? "txt" : "bin")));
+      }
+      else
+      {
+        iReturn = ERANGE; /* Error */
+      }
+    }
+    else /* Argument is a file ... */
+    {
+      g_tState.tWrFile.hFile = esx_f_open(g_tState.tWrFile.acPathName, ESXDOS_MODE_R | ESXDOS_MODE_OE);
+
+      if (INV_FILE_HND != g_tState.tWrFile.hFile)
+      {
+        esx_f_close(g_tState.tWrFile.hFile);
+        g_tState.tWrFile.hFile = INV_FILE_HND;
+
+        if (g_tState.bForce)
+        {
+          esx_f_unlink(g_tState.tWrFile.acPathName);
+        }
+        else
+        {
+          iReturn = EBADF; /* Error: File exists */
+        }
+      }
+    }
+  }
+
+  if (EOK == iReturn)
+  {
+    g_tState.tWrFile.hFile = esx_f_open(g_tState.tWrFile.acPathName, ESXDOS_MODE_W | ESXDOS_MODE_CN);
+
+    if (INV_FILE_HND == g_tState.tWrFile.hFile)
+    {
+      iReturn = EACCES; /* Error */
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sortRegions()                                                              */
+/*----------------------------------------------------------------------------*/
+static void sortRegions(void)
+{
+  /* Insertion sort by datasource and address (only a few entries) */
+  for (uint8_t i = 1; i < g_tState.uiRegions; ++i)
+  {
+    region_t tRegion = g_tState.tRegion[i];
+    uint8_t  j = i;
+
+    while ((0 < j) &&
+           ((g_tState.tRegion[j - 1].eMode > tRegion.eMode) ||
+            ((g_tState.tRegion[j - 1].eMode == tRegion.eMode) &&
+             (g_tState.tRegion[j - 1].uiOffset > tRegion.uiOffset))))
+    {
+      g_tState.tRegion[j] = g_tState.tRegion[j - 1];
+      --j;
+    }
+
+    g_tState.tRegion[j] = tRegion;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readRegions()                                                              */
+/*----------------------------------------------------------------------------*/
+static int readRegions(const char_t* acPathName)
+{
+  int iReturn = EOK;
+  uint8_t hFile;
+
+  if (INV_FILE_HND != (hFile = esx_f_open(acPathName, ESX_MODE_READ | ESX_MODE_OPEN_EXIST)))
+  {
+    char_t  acLine[48];
+    char_t  acChunk[32];
+    uint8_t uiLen = 0;
+    size_t  uiRead;
+
+    while ((EOK == iReturn) && (0 < (uiRead = esx_f_read(hFile, acChunk, sizeof(acChunk)))))
+    {
+      for (uint8_t i = 0; (EOK == iReturn) && (i < uiRead); ++i)
+      {
+        if (('\n' == acChunk[i]) || ('\r' == acChunk[i]))
+        {
+          acLine[uiLen] = '\0';
+          iReturn = parseRegion(acLine);
+          uiLen = 0;
+        }
+        else if (uiLen < (sizeof(acLine) - 1))
+        {
+          acLine[uiLen++] = acChunk[i];
+        }
+        else
+        {
+          fprintf(stderr, "line too long in %s (max. %u characters)\n", acPathName, (uint16_t) (sizeof(acLine) - 1));
+          iReturn = ERANGE;
+        }
+      }
+    }
+
+    if (EOK == iReturn)
+    {
+      acLine[uiLen] = '\0';
+      iReturn = parseRegion(acLine);
+    }
+
+    esx_f_close(hFile);
+  }
+  else
+  {
+    fprintf(stderr, "unable to open %s\n", acPathName);
+    iReturn = EBADF;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* parseRegion()                                                              */
+/*----------------------------------------------------------------------------*/
+static int parseRegion(char_t* acLine)
+{
+  int iReturn = EOK;
+  dumpmode_t eMode = g_tState.eMode;
+  char* pEnd;
+
+  while ((' ' == *acLine) || ('\t' == *acLine))
+  {
+    ++acLine;
+  }
+
+  if (('\0' != *acLine) && ('#' != *acLine)) /* Skip empty lines and comments */
+  {
+    switch (*acLine)
+    {
+      case 'l':
+      case 'L':
+        eMode = DUMP_LOGICAL;
+        ++acLine;
+        break;
+
+      case 'p':
+      case 'P':
+        eMode = DUMP_PHYSICAL;
+        ++acLine;
+        break;
+
+      case 'f':
+      case 'F':
+        eMode = DUMP_FILE;
+        ++acLine;
+        break;
+
+      case 'n':
+      case 'N':
+        eMode = DUMP_NEXTREG;
+        ++acLine;
+        break;
+
+      case 'c':
+      case 'C':
+        eMode = DUMP_PALETTE;
+        ++acLine;
+        break;
+
+      case 't':
+      case 'T':
+        eMode = DUMP_TILEMAP;
+        ++acLine;
+        break;
+
+      case 'd':
+      case 'D':
+        eMode = DUMP_DISK;
+        ++acLine;
+        break;
+    }
+
+    if (EOK == (iReturn = addRegion(eMode, strtoul((char*) acLine, &pEnd, 0))))
+    {
+      g_tState.tRegion[g_tState.uiRegions - 1].uiSize = strtoul(pEnd, 0, 0);
+    }
+    else
+    {
+      fprintf(stderr, "too many regions (max. %u)\n", uiMAX_REGIONS);
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* scanOutputDir()                                                            */
+/*----------------------------------------------------------------------------*/
+static void scanOutputDir(void)
+{
+  uint8_t hDir;
+
+  if (INV_FILE_HND != (hDir = esx_f_opendir_ex(g_tState.tWrFile.acPathName, ESX_DIR_USE_LFN)))
+  {
+    static const char_t acPrefix[] = VER_INTERNALNAME_STR "-";
+    struct esx_dirent_lfn tEntry;
+    char* pEnd;
+
+    snprintf(g_tState.acOutDir, sizeof(g_tState.acOutDir), "%s", g_tState.tWrFile.acPathName);
+    g_tState.bOutDir  = true;
+    g_tState.uiOutIdx = 0;
+
+    /* One pass through the directory: next index = highest index + 1 (the
+       index stops at 0xFFFF, "openOutput()" fails then; esx_f_readdir()
+       returns 1 for an entry, 0 at the end and 0xFF on error) */
+    while (1 == esx_f_readdir(hDir, &tEntry))
+    {
+      if (0 == strnicmp((const char*) tEntry.name, acPrefix, sizeof(acPrefix) - 1))
+      {
+        uint32_t uiIdx = strtoul((const char*) &tEntry.name[sizeof(acPrefix) - 1], &pEnd, 10);
+
+        if (('.' == *pEnd) && (uiIdx >= g_tState.uiOutIdx))
+        {
+          g_tState.uiOutIdx = (uiIdx < 0xFFFF ? ((uint16_t) uiIdx) + 1 : 0xFFFF);
+        }
+      }
+    }
+
+    esx_f_closedir(hDir);
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* selectSource()                                                             */
+/*----------------------------------------------------------------------------*/
+static int selectSource(dumpmode_t eMode)
+{
+  int iReturn = EOK;
+
+  if (eMode != g_tState.tSource.eMode)
+  {
+    sourceClose(&g_tState.tSource);
+    iReturn = sourceOpen(&g_tState.tSource, eMode, &g_tState.tRdFile);
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dumpRaw()                                                                  */
+/*----------------------------------------------------------------------------*/
+static int dumpRaw(void)
+{
+  int iReturn = EOK;
+
+  uint32_t uiAddr = g_tState.tRead.uiLower;
+
+  while ((EOK == iReturn) && (uiAddr < g_tState.tRead.uiUpper))
+  {
+    uint32_t uiLen = g_tState.tRead.uiUpper - uiAddr;
+
+    if (uiLen > uiBLOCK_SIZE)
+    {
+      uiLen = uiBLOCK_SIZE;
+    }
+
+    if (EOK == (iReturn = readBlock(&g_tState.tSource, uiAddr, (uint16_t) uiLen)))
+    {
+      /* Export of the interactive mode: the modified data is saved */
+      editPatch(uiAddr, g_tState.tSource.pBlock, (uint16_t) uiLen);
+
+      iReturn = saveBlock(g_tState.tSource.pBlock, (uint16_t) uiLen, &g_tState.tWrFile);
+    }
+
+    uiAddr += uiLen;
+  }
+
+  g_tState.tRead.uiAddr = g_tState.tRead.uiEnd;
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* jumpBlock()                                                                */
+/*----------------------------------------------------------------------------*/
+static uint32_t jumpBlock(uint32_t uiAddr, bool bNext)
+{
+  uint32_t uiReturn = uiAddr;
+  uint32_t uiMask   = ~(((uint32_t) g_tState.tRead.uiStride) - UINT32_C(1));
+  uint8_t  uiIndex  = tapeFind(uiAddr);
+
+  if (uiTAPE_NONE != uiIndex)
+  {
+    uint32_t uiPos  = 0;
+    uint32_t uiSize = 0;
+
+    (void) tapeBlock(uiIndex, &uiPos, &uiSize, 0);
+
+    /* Previous: start of the current block, if it is not visible */
+    if (bNext)
+    {
+      ++uiIndex;
+    }
+    else if (((uiPos & uiMask) == uiAddr) && (0 < uiIndex))
+    {
+      --uiIndex;
+    }
+
+    if (EOK == tapeBlock(uiIndex, &uiPos, &uiSize, 0))
+    {
+      if ((uiPos >= g_tState.tRead.uiLower) && (uiPos < g_tState.tRead.uiUpper))
+      {
+        uiReturn = uiPos & uiMask;
+      }
+    }
+  }
+
+  return uiReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* watchSample()                                                              */
+/*----------------------------------------------------------------------------*/
+static int watchSample(uint32_t uiAddr)
+{
+  int iReturn = EOK;
+  cellinfo_t tCell;
+
+  /* Memory changes behind the block buffer of the datasource */
+  sourceFlush(&g_tState.tSource);
+
+  g_tState.tRead.uiAddr = uiAddr;
+
+  for (uint8_t i = 0; i < g_tState.tScreen.uiRows - 1; ++i)
+  {
+    if (EOK != (iReturn = readFrame(&g_tState.tSource, &g_tState.tRead)))
+    {
+      break;
+    }
+
+    editApply(&g_tState.tRead);
+
+    uint8_t* pLast    = g_tState.tWatch.uiData[i];
+    uint16_t uiMarked = g_tState.tWatch.uiMarked[i];
+    uint16_t uiBit    = 1;
+
+    /* Unchanged row without highlights: nothing to redraw */
+    if ((0 == uiMarked) &&
+        (g_tState.tRead.uiStride == zxn_mismatch(pLast, g_tState.tRead.uiData, g_tState.tRead.uiStride)))
+    {
+      zxn_add32(&g_tState.tRead.uiAddr, g_tState.tRead.uiStride);
+      continue;
+    }
+
+    for (uint8_t j = 0; j < g_tState.tRead.uiStride; ++j, uiBit <<= 1)
+    {
+      bool bChanged = (pLast[j] != g_tState.tRead.uiData[j]);
+
+      if (bChanged || (0 != (uiMarked & uiBit)))
+      {
+        uint16_t uiIdx    = (((uint16_t) i) * g_tState.tRead.uiStride) + j;
+        bool     bInverse = (bChanged != (uiIdx == g_tState.tCursor.uiIdx));
+
+        /* The bytes under the cursor are decoded again by the panel */
+        if (bChanged && (uiIdx >= g_tState.tCursor.uiIdx) && (uiIdx < (g_tState.tCursor.uiIdx + 4)))
+        {
+          g_tState.tCursor.bDirty = true;
+        }
+
+        if (EOK == renderCell(&g_tState.tRead, &g_tState.tRender, j, &tCell))
+        {
+          if (bInverse)
+          {
+            zxn_inverse(true);
+          }
+
+          if (uiNO_COLUMN != tCell.uiHexCol)
+          {
+            zxn_gotoxy(tCell.uiHexCol, i);
+            printf("%s", tCell.acHex);
+          }
+
+          if (uiNO_COLUMN != tCell.uiCharCol)
+          {
+            zxn_gotoxy(tCell.uiCharCol, i);
+            printf("%s", tCell.acChar);
+          }
+
+          if (bInverse)
+          {
+            zxn_inverse(false);
+          }
+        }
+
+        pLast[j] = g_tState.tRead.uiData[j];
+        uiMarked = (bChanged ? (uiMarked | uiBit) : (uiMarked & ~uiBit));
+      }
+    }
+
+    g_tState.tWatch.uiMarked[i] = uiMarked;
+    zxn_add32(&g_tState.tRead.uiAddr, g_tState.tRead.uiStride);
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* drawPanel()                                                                */
+/*----------------------------------------------------------------------------*/
+static void drawPanel(uint32_t uiAddr, bool bLabels)
+{
+  if (0 != g_tState.tCursor.uiPanelCol)
+  {
+    uint16_t uiSize = ((uint16_t) (g_tState.tScreen.uiRows - 1)) * g_tState.tRead.uiStride;
+    uint32_t uiCursor = uiAddr + g_tState.tCursor.uiIdx;
+    uint8_t  uiData[4];
+    uint8_t  uiLen = 0;
+    char_t   acText[uiDECODE_COLS + 1];
+
+    /* Bytes under the cursor (from the copy of the window; up to the end of
+       the window or the region) */
+    while (uiLen < sizeof(uiData))
+    {
+      uint16_t uiIdx = g_tState.tCursor.uiIdx + uiLen;
+
+      if ((uiIdx >= uiSize) ||
+          !between_uint32(uiCursor + uiLen, g_tState.tRead.uiLower, g_tState.tRead.uiUpper, 1))
+      {
+        break;
+      }
+
+      uiData[uiLen++] = g_tState.tWatch.uiData[uiIdx / g_tState.tRead.uiStride][uiIdx % g_tState.tRead.uiStride];
+    }
+
+    for (uint8_t i = (bLabels ? 0 : 1); (i < uiDECODE_ROWS) && (i < (g_tState.tScreen.uiRows - 1)); i += (bLabels ? 1 : 2))
+    {
+      if (EOK == renderDecode(uiData, uiLen, uiCursor, i, acText))
+      {
+        zxn_gotoxy(g_tState.tCursor.uiPanelCol, i);
+        printf("%s", acText);
+      }
+    }
+  }
+
+  g_tState.tCursor.bDirty = false;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* drawCell()                                                                 */
+/*----------------------------------------------------------------------------*/
+static void drawCell(uint32_t uiAddr, uint16_t uiIdx, bool bCursor)
+{
+  uint8_t      uiRow = uiIdx / g_tState.tRead.uiStride;
+  uint8_t      uiCol = uiIdx % g_tState.tRead.uiStride;
+  readbuffer_t tRow  = g_tState.tRead;
+  cellinfo_t   tCell;
+
+  tRow.uiAddr = uiAddr + (((uint32_t) uiRow) * g_tState.tRead.uiStride);
+  zxn_ldi(tRow.uiData, g_tState.tWatch.uiData[uiRow], tRow.uiStride);
+
+  if (EOK == renderCell(&tRow, &g_tState.tRender, uiCol, &tCell))
+  {
+    bool bInverse = (bCursor != (0 != (g_tState.tWatch.uiMarked[uiRow] & (((uint16_t) 1) << uiCol))));
+
+    if (bInverse)
+    {
+      zxn_inverse(true);
+    }
+
+    if (uiNO_COLUMN != tCell.uiHexCol)
+    {
+      zxn_gotoxy(tCell.uiHexCol, uiRow);
+      printf("%s", tCell.acHex);
+    }
+
+    if (uiNO_COLUMN != tCell.uiCharCol)
+    {
+      zxn_gotoxy(tCell.uiCharCol, uiRow);
+      printf("%s", tCell.acChar);
+    }
+
+    if (bInverse)
+    {
+      zxn_inverse(false);
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* showStatus()                                                               */
+/*----------------------------------------------------------------------------*/
+static void showStatus(const char_t* acText)
+{
+  uint8_t uiLen = 0;
+
+  zxn_gotoxy(0, g_tState.tScreen.uiRows - 1);
+
+  /* The last column is not used: the screen would scroll */
+  while (('\0' != acText[uiLen]) && (uiLen < (g_tState.tScreen.uiCols - 1)))
+  {
+    putchar(acText[uiLen++]);
+  }
+
+  while (uiLen++ < (g_tState.tScreen.uiCols - 1))
+  {
+    putchar(' ');
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* exportRange()                                                              */
+/*----------------------------------------------------------------------------*/
+static int exportRange(bool bHex)
+{
+  int iReturn = EOK;
+
+  readbuffer_t tWindow = g_tState.tRead;
+  bool         bSaveHex = g_tState.bHex;
+  uint32_t     uiFirst = g_tState.tCursor.uiMark[0];
+  uint32_t     uiLast  = g_tState.tCursor.uiMark[1];
+
+  if (uiFirst > uiLast)
+  {
+    uiFirst = g_tState.tCursor.uiMark[1];
+    uiLast  = g_tState.tCursor.uiMark[0];
+  }
+
+  if ((uiFirst < tWindow.uiLower) || (uiLast >= tWindow.uiUpper))
+  {
+    iReturn = ERANGE;
+  }
+
+  /* New file in the export directory (next unused index) */
+  if (EOK == iReturn)
+  {
+    g_tState.bHex = bHex;
+    snprintf(g_tState.tWrFile.acPathName, sizeof(g_tState.tWrFile.acPathName), "%s", acEXPORT_DIR);
+
+    g_tState.bOutDir  = false;
+    g_tState.uiOutIdx = 0;
+
+    scanOutputDir();
+
+    iReturn = (g_tState.bOutDir ? openOutput() : EBADF);
+  }
+
+  if (EOK == iReturn)
+  {
+    setBounds(uiFirst, uiLast - uiFirst + 1);
+
+    if (EOK == (iReturn = (bHex ? dumpHex() : dumpRaw())))
+    {
+      iReturn = saveFlush(&g_tState.tWrFile);
+    }
+  }
+
+  if (INV_FILE_HND != g_tState.tWrFile.hFile)
+  {
+    esx_f_close(g_tState.tWrFile.hFile);
+    g_tState.tWrFile.hFile = INV_FILE_HND;
+
+    if (EOK != iReturn)
+    {
+      esx_f_unlink(g_tState.tWrFile.acPathName);
+    }
+  }
+
+  /* The block buffer holds the modified data of the export */
+  if (0 != editCount())
+  {
+    sourceFlush(&g_tState.tSource);
+  }
+
+  g_tState.tRead = tWindow;
+  g_tState.bHex  = bSaveHex;
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* dumpHex()                                                                  */
+/*----------------------------------------------------------------------------*/
+static int dumpHex(void)
+{
+  int iReturn = EOK;
+
+  uint32_t uiAddr = g_tState.tRead.uiBegin;
+
+  while ((EOK == iReturn) && (uiAddr < g_tState.tRead.uiEnd))
+  {
+    /* Block of frames; only the part within the bounds is read */
+    uint32_t uiFirst = (uiAddr < g_tState.tRead.uiLower ? g_tState.tRead.uiLower : uiAddr);
+    uint32_t uiLast  = uiAddr + uiBLOCK_SIZE;
+
+    if (uiLast > g_tState.tRead.uiUpper)
+    {
+      uiLast = g_tState.tRead.uiUpper;
+    }
+
+    if (EOK == (iReturn = readBlock(&g_tState.tSource, uiFirst, (uint16_t) (uiLast - uiFirst))))
+    {
+      editPatch(uiFirst, g_tState.tSource.pBlock, (uint16_t) (uiLast - uiFirst));
+
+      for (g_tState.tRead.uiAddr = uiAddr; g_tState.tRead.uiAddr < uiLast; g_tState.tRead.uiAddr += g_tState.tRead.uiStride)
+      {
+        uint32_t uiFrom = (g_tState.tRead.uiAddr < uiFirst ? uiFirst : g_tState.tRead.uiAddr);
+        uint32_t uiTo   = g_tState.tRead.uiAddr + g_tState.tRead.uiStride;
+
+        if (uiTo > uiLast)
+        {
+          uiTo = uiLast;
+        }
+
+        /* renderFrame() shows only the bytes within the bounds */
+        zxn_ldi(&g_tState.tRead.uiData[uiFrom - g_tState.tRead.uiAddr],
+                &g_tState.tSource.pBlock[uiFrom - uiFirst],
+                (uint16_t) (uiTo - uiFrom));
+
+        renderFrame(&g_tState.tScreen, &g_tState.tRead, &g_tState.tRender);
+
+        if (EOK != (iReturn = saveFrame(&g_tState.tRead, &g_tState.tRender, &g_tState.tWrFile)))
+        {
+          break;
+        }
+      }
+    }
+
+    uiAddr += uiBLOCK_SIZE;
+  }
+
+  g_tState.tRead.uiAddr = g_tState.tRead.uiEnd;
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* moveCursor()                                                               */
+/*----------------------------------------------------------------------------*/
+static bool moveCursor(uint32_t* pAddr, int iKey)
+{
+  bool     bReturn = false;
+  uint32_t uiAddr  = *pAddr;
+  uint16_t uiIdx   = g_tState.tCursor.uiIdx;
+  uint16_t uiSize  = ((uint16_t) (g_tState.tScreen.uiRows - 1)) * g_tState.tRead.uiStride;
+  uint8_t  uiStep  = (('h' == iKey) || ('l' == iKey) ? 1 : g_tState.tRead.uiStride);
+
+  /* At the edges of the window the window is scrolled by a line */
+  if (('h' == iKey) || ('k' == iKey))
+  {
+    if (uiIdx >= uiStep)
+    {
+      uiIdx -= uiStep;
+    }
+    else if (uiAddr > g_tState.tRead.uiLower)
+    {
+      uiAddr -= ((uint32_t) g_tState.tRead.uiStride);
+      uiIdx  += (g_tState.tRead.uiStride - uiStep);
+    }
+  }
+  else
+  {
+    if ((uiIdx + uiStep) < uiSize)
+    {
+      uiIdx += uiStep;
+    }
+    else if ((uiAddr + uiSize) < g_tState.tRead.uiUpper)
+    {
+      uiAddr += ((uint32_t) g_tState.tRead.uiStride);
+      uiIdx  -= (g_tState.tRead.uiStride - uiStep);
+    }
+  }
+
+  if (*pAddr != uiAddr)
+  {
+    *pAddr = uiAddr;
+    g_tState.tCursor.uiIdx = uiIdx;
+    bReturn = true;
+  }
+  else if (uiIdx != g_tState.tCursor.uiIdx)
+  {
+    /* Only the old and the new cell and the values of the panel are drawn
+       again */
+    drawCell(uiAddr, g_tState.tCursor.uiIdx, false);
+    g_tState.tCursor.uiIdx = uiIdx;
+    drawCell(uiAddr, uiIdx, true);
+    drawPanel(uiAddr, false);
+  }
+
+  return bReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* editCursor()                                                               */
+/*----------------------------------------------------------------------------*/
+static bool editCursor(uint32_t* pAddr, int iKey)
+{
+  bool     bReturn = false;
+  uint16_t uiIdx   = g_tState.tCursor.uiIdx;
+  uint8_t* pByte   = &g_tState.tWatch.uiData[uiIdx / g_tState.tRead.uiStride][uiIdx % g_tState.tRead.uiStride];
+  uint32_t uiAddr  = *pAddr + uiIdx;
+  uint8_t  uiDigit = (iKey <= '9' ? iKey - '0' : (iKey | 0x20) - 'a' + 10);
+  uint8_t  uiValue;
+  int      iResult;
+
+  if (between_uint32(uiAddr, g_tState.tRead.uiLower, g_tState.tRead.uiUpper, 1))
+  {
+    uiValue = (g_tState.tCursor.bNibble ?
+               (*pByte & 0xF0) | uiDigit :
+               (*pByte & 0x0F) | (uiDigit << 4));
+
+    if (EOK == (iResult = editPoke(uiAddr, uiValue)))
+    {
+      /* The copy of the window holds the modified data */
+      *pByte = uiValue;
+
+      if (g_tState.tCursor.bNibble)
+      {
+        g_tState.tCursor.bNibble = false;
+
+        drawCell(*pAddr, uiIdx, true);
+        bReturn = moveCursor(pAddr, 'l');
+      }
+      else
+      {
+        g_tState.tCursor.bNibble = true;
+        drawCell(*pAddr, uiIdx, true);
+      }
+
+      drawPanel(*pAddr, false);
+    }
+    else
+    {
+      showStatus(zxn_strerror(iResult));
+    }
+  }
+
+  return bReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* squeezeFrames()                                                            */
+/*----------------------------------------------------------------------------*/
+static uint16_t squeezeFrames(const uint8_t* pLast)
+{
+  uint16_t uiReturn = 0;
+
+  const source_t*     pSource  = &g_tState.tSource;
+  const readbuffer_t* pRead    = &g_tState.tRead;
+  uint8_t             uiStride = pRead->uiStride;
+  uint32_t            uiNext   = pRead->uiAddr + uiStride;
+  uint32_t            uiEnd    = pSource->uiBlockAddr + pSource->uiBlockLen;
+
+  if (uiEnd > pRead->uiEnd)
+  {
+    uiEnd = pRead->uiEnd;
+  }
+
+  /* Only lines of one value repeat in a block, that is filled with it */
+  if ((uiNext >= pSource->uiBlockAddr) && (uiNext < uiEnd) &&
+      zxn_memeq(pLast, uiStride, pLast[0]))
+  {
+    uint16_t uiLen = (uint16_t) (uiEnd - uiNext);
+
+    uiLen -= (uiLen % uiStride);
+
+    if (zxn_memeq(&pSource->pBlock[(uint16_t) (uiNext - pSource->uiBlockAddr)], uiLen, pLast[0]))
+    {
+      uiReturn = uiLen;
+    }
+  }
+
+  return uiReturn;
 }
 
 
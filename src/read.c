@@ -48,10 +48,63 @@
 #include "libzxn.h"
 #include "bindump.h"
 #include "read.h"
+#include "buffer.h"
+#include "unpack.h"
 
 /*============================================================================*/
 /*                               Defines                                      */
 /*============================================================================*/
+/*!
+Max. distance of a forward seek with the current handle; larger jumps start at
+the nearest checkpoint
+*/
+#define uiCHECK_GAP (UINT32_C(0x4000))
+
+/*!
+Size of the physical memory (2MB)
+*/
+#define uiPHYS_MEM_SIZE (UINT32_C(0x200000))
+
+/*!
+Size of a physical memory page (8K)
+*/
+#define uiPHYS_PAGE_SIZE (0x2000)
+
+/*!
+Logical address of the MMU slot used to map physical pages (MMU6)
+*/
+#define uiPHYS_WINDOW (0xC000)
+
+/*!
+Number of Next registers (0x00 - 0xFF)
+*/
+#define uiNEXTREG_SIZE (UINT32_C(0x100))
+
+/*!
+Size of all palettes: 8 palettes with 256 entries of 2 bytes (9 bit colour)
+*/
+#define uiPALETTE_SIZE (UINT32_C(0x1000))
+
+/*!
+Next registers to access the palettes and the tilemap
+*/
+#define REG_PAL_INDEX   (0x40)
+#define REG_PAL_VALUE8  (0x41)
+#define REG_PAL_CONTROL (0x43)
+#define REG_PAL_VALUE9  (0x44)
+#define REG_TM_CONTROL  (0x6B)
+#define REG_TM_BASE     (0x6E)
+
+/*!
+Physical addresses of the 16K banks 5 and 7 (location of the tilemap)
+*/
+#define uiPHYS_BANK_5 (UINT32_C(0x14000))
+#define uiPHYS_BANK_7 (UINT32_C(0x1C000))
+
+/*!
+Size of a disk sector
+*/
+#define uiSECTOR_SIZE (0x200)
 
 /*============================================================================*/
 /*                               Namespaces                                   */
@@ -64,6 +117,25 @@
 /*============================================================================*/
 /*                               Variablen                                    */
 /*============================================================================*/
+/*!
+Last sector read from a disk (used, if the cache buffer is not available)
+*/
+static uint8_t g_uiSector[uiSECTOR_SIZE];
+
+/*!
+Number (LBA) of the first sector in the sector buffer
+*/
+static uint32_t g_uiSectorNo = uiPOS_UNKNOWN;
+
+/*!
+Position of the window of the input file in the read buffer
+*/
+static uint32_t g_uiWindowPos = uiPOS_UNKNOWN;
+
+/*!
+Number of valid bytes in the window of the input file
+*/
+static uint16_t g_uiWindowLen = 0;
 
 /*============================================================================*/
 /*                               Strukturen                                   */
@@ -76,27 +148,230 @@
 /*============================================================================*/
 /*                               Prototypen                                   */
 /*============================================================================*/
-/*
-Read a data frame from logical memory
-@param pRead Pointer to the read buffer
-@return negativ values on errors; positive values are length of read data
+/*!
+Prepare a memory based datasource (nothing to do)
+@param pSource Pointer to the datasource
+@return EOK = no error
+*/
+static int openSource_memory(source_t* pSource);
+
+/*!
+Release a memory based datasource (nothing to do)
+@param pSource Pointer to the datasource
+*/
+static void closeSource_memory(source_t* pSource);
+
+/*!
+Read a block of data from logical memory
+@param pSource Pointer to the datasource
+@param uiAddr Logical address of the first byte
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
+*/
+static int readBlock_logical(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Query the size of logical memory
+@param pSource Pointer to the datasource
+@return Size in bytes
+*/
+static uint32_t sizeSource_logical(source_t* pSource);
+
+/*!
+Start reading a block of data from logical memory in the background (DMA)
+@param pSource Pointer to the datasource
+@param uiAddr Logical address of the first byte
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error; ENOTSUP = block wraps around the end of the 64K
+*/
+static int fetchBlock_logical(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Write a block of data to logical memory
+@param pSource Pointer to the datasource
+@param uiAddr Logical address of the first byte
+@param pData Pointer to the data
+@param uiLen Number of bytes to write
+@return EOK = no error
+*/
+static int writeBlock_logical(source_t* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen);
+
+/*!
+Read a block of data from physical memory
+@param pSource Pointer to the datasource
+@param uiAddr Physical address of the first byte
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
+*/
+static int readBlock_physical(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Query the size of physical memory
+@param pSource Pointer to the datasource
+@return Size in bytes
+*/
+static uint32_t sizeSource_physical(source_t* pSource);
+
+/*!
+Start reading a block of data from physical memory in the background (DMA).
+The page stays mapped into MMU6 until "sourceWait()" is called.
+@param pSource Pointer to the datasource
+@param uiAddr Physical address of the first byte
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error; ENOTSUP = block crosses a page boundary
+*/
+static int fetchBlock_physical(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Write a block of data to physical memory
+@param pSource Pointer to the datasource
+@param uiAddr Physical address of the first byte
+@param pData Pointer to the data
+@param uiLen Number of bytes to write
+@return EOK = no error
+*/
+static int writeBlock_physical(source_t* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen);
+
+/*!
+Prepare a file based datasource; the file itself is opened by "openFile()"
+@param pSource Pointer to the datasource
+@return EOK = no error
+*/
+static int openSource_file(source_t* pSource);
+
+/*!
+Read a block of data from a file
+@param pSource Pointer to the datasource
+@param uiAddr Offset of the first byte (relative to the base of the file)
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
+*/
+static int readBlock_file(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Query the size of a file
+@param pSource Pointer to the datasource
+@return Size in bytes
+*/
+static uint32_t sizeSource_file(source_t* pSource);
+
+/*!
+Write a block of data to a file (one seek and one write)
+@param pSource Pointer to the datasource
+@param uiAddr Offset of the first byte (relative to the base of the file)
+@param pData Pointer to the data
+@param uiLen Number of bytes to write
+@return EOK = no error
+*/
+static int writeBlock_file(source_t* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen);
+
+/*!
+Read a block of decoded data from a compressed file
+@param pSource Pointer to the datasource
+@param uiAddr Offset of the first byte in the decoded data
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
+*/
+static int readBlock_packed(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Query the size of the decoded data of a compressed file
+@param pSource Pointer to the datasource
+@return Size in bytes
+*/
+static uint32_t sizeSource_packed(source_t* pSource);
+
+/*!
+Read a block of Next registers
+@param pSource Pointer to the datasource
+@param uiAddr Number of the first register
+@param pData Pointer to the destination buffer
+@param uiLen Number of registers to read
+@return EOK = no error
+*/
+static int readBlock_nextreg(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Query the number of Next registers
+@param pSource Pointer to the datasource
+@return Number of registers
+*/
+static uint32_t sizeSource_nextreg(source_t* pSource);
+
+/*!
+Read a block of palette entries. The address selects the palette (bits 11-9),
+the entry (bits 8-1) and the byte of the 9 bit colour (bit 0):
+ULA, Layer 2, Sprites, Tilemap (first palettes), ULA, ... (second palettes)
+@param pSource Pointer to the datasource
+@param uiAddr Address of the first byte
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
+*/
+static int readBlock_palette(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Query the size of all palettes
+@param pSource Pointer to the datasource
+@return Size in bytes
+*/
+static uint32_t sizeSource_palette(source_t* pSource);
+
+/*!
+Read a block of the tilemap (bank 5/7, base from NextReg 0x6E)
+@param pSource Pointer to the datasource
+@param uiAddr Offset of the first byte in the tilemap
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
+*/
+static int readBlock_tilemap(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
+
+/*!
+Query the size of the tilemap (40x32 or 80x32 entries of 1 or 2 bytes)
+@param pSource Pointer to the datasource
+@return Size in bytes
+*/
+static uint32_t sizeSource_tilemap(source_t* pSource);
+
+/*!
+Prepare a disk datasource (invalidate the sector buffer)
+@param pSource Pointer to the datasource
+@return EOK = no error
 */
-static int readFrame_logical(readbuffer_t* pRead);
+static int openSource_disk(source_t* pSource);
 
 /*!
-Read a data frame from physical memory
-@param pRead Pointer to the read buffer
-@return negativ values on errors; positive values are length of read data
+Read a block of data from a disk. The disk is addressed bytewise; the sector
+(LBA) is the address divided by the sector size.
+@param pSource Pointer to the datasource
+@param uiAddr Address of the first byte on the disk
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
 */
-static int readFrame_physical(readbuffer_t* pRead);
+static int readBlock_disk(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen);
 
 /*!
-Read a data frame from a file
-@param pRead Pointer to the read buffer
+Query the size of a disk (unknown: the whole 32 bit address space)
+@param pSource Pointer to the datasource
+@return Size in bytes
+*/
+static uint32_t sizeSource_disk(source_t* pSource);
+
+/*!
+Move the read position of a file to the given position
 @param pFile Pointer to the file info
-@return negativ values on errors; positive values are length of read data
+@param uiTarget New position in the file
+@return EOK = no error
 */
-static int readFrame_file(readbuffer_t* pRead, fileinfo_t* pFile);
+static int seekFile(fileinfo_t* pFile, uint32_t uiTarget);
 
 /*============================================================================*/
 /*                               Klassen                                      */
@@ -106,61 +381,158 @@ static int readFrame_file(readbuffer_t* pRead, fileinfo_t* pFile);
 /*                               Implementierung                              */
 /*============================================================================*/
 
+/*!
+Implementations of the datasources (index: dumpmode_t - DUMP_LOGICAL)
+*/
+static const srcops_t g_tSourceOps[] =
+{
+  {openSource_memory, readBlock_logical,  sizeSource_logical,  closeSource_memory, fetchBlock_logical,  writeBlock_logical},  /* DUMP_LOGICAL  */
+  {openSource_memory, readBlock_physical, sizeSource_physical, closeSource_memory, fetchBlock_physical, writeBlock_physical}, /* DUMP_PHYSICAL */
+  {openSource_file,   readBlock_file,     sizeSource_file,     closeSource_memory, 0,                   writeBlock_file},     /* DUMP_FILE     */
+  {openSource_memory, readBlock_nextreg,  sizeSource_nextreg,  closeSource_memory, 0,                   0},                   /* DUMP_NEXTREG  */
+  {openSource_memory, readBlock_palette,  sizeSource_palette,  closeSource_memory, 0,                   0},                   /* DUMP_PALETTE  */
+  {openSource_memory, readBlock_tilemap,  sizeSource_tilemap,  closeSource_memory, 0,                   0},                   /* DUMP_TILEMAP  */
+  {openSource_disk,   readBlock_disk,     sizeSource_disk,     closeSource_memory, 0,                   0},                   /* DUMP_DISK     */
+};
+
+/*!
+Implementation of the datasource of a compressed file (DUMP_FILE)
+*/
+static const srcops_t g_tPackedOps =
+  {openSource_file,   readBlock_packed,   sizeSource_packed,   closeSource_memory};
+
+
 /*----------------------------------------------------------------------------*/
-/* readFrame()                                                                */
+/* sourceOpen()                                                               */
 /*----------------------------------------------------------------------------*/
-int readFrame(dumpmode_t eMode, fileinfo_t* pFile, readbuffer_t* pRead)
+int sourceOpen(source_t* pSource, dumpmode_t eMode, fileinfo_t* pFile)
 {
-  int iReturn = EINVAL;
+  int iReturn = EOK;
 
-  if ((0 != pFile) && (0 != pRead))
+  if (0 != pSource)
   {
-    switch (eMode)
+    pSource->pOps        = 0;
+    pSource->eMode       = DUMP_NONE;
+    pSource->pFile       = pFile;
+    pSource->uiBlockAddr = 0;
+    pSource->uiBlockLen  = 0;
+    pSource->pBlock      = pSource->uiBuffer[0];
+    pSource->pFetch      = pSource->uiBuffer[1];
+    pSource->bFetch      = false;
+    pSource->bFetchMmu   = false;
+
+    if ((DUMP_LOGICAL <= eMode) && ((eMode - DUMP_LOGICAL) < (sizeof(g_tSourceOps) / sizeof(g_tSourceOps[0]))))
+    {
+      pSource->pOps  = &g_tSourceOps[eMode - DUMP_LOGICAL];
+      pSource->eMode = eMode;
+
+      if (EOK != (iReturn = pSource->pOps->pfnOpen(pSource)))
+      {
+        pSource->pOps  = 0;
+        pSource->eMode = DUMP_NONE;
+      }
+    }
+    else
     {
-      case DUMP_NONE:
-        iReturn = -1 * ERANGE;
-        break;
+      iReturn = ERANGE;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
 
-      case DUMP_LOGICAL:
-        iReturn = readFrame_logical(pRead);
-        break;
+  return iReturn;
+}
 
-      case DUMP_PHYSICAL:
-        iReturn = readFrame_physical(pRead);
-        break;
 
-      case DUMP_FILE:
-        iReturn = readFrame_file(pRead, pFile);
-        break;
-    }
+/*----------------------------------------------------------------------------*/
+/* sourceSize()                                                               */
+/*----------------------------------------------------------------------------*/
+uint32_t sourceSize(source_t* pSource)
+{
+  uint32_t uiReturn = 0;
 
-    iReturn = (0 <= iReturn ? EOK : -1 * iReturn);
+  if ((0 != pSource) && (0 != pSource->pOps))
+  {
+    uiReturn = pSource->pOps->pfnSize(pSource);
   }
 
-  return iReturn;
+  return uiReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sourceClose()                                                              */
+/*----------------------------------------------------------------------------*/
+void sourceClose(source_t* pSource)
+{
+  if ((0 != pSource) && (0 != pSource->pOps))
+  {
+    sourceWait(pSource);
+    pSource->bFetch = false;
+
+    pSource->pOps->pfnClose(pSource);
+
+    pSource->pOps       = 0;
+    pSource->eMode      = DUMP_NONE;
+    pSource->uiBlockLen = 0;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sourceFlush()                                                              */
+/*----------------------------------------------------------------------------*/
+void sourceFlush(source_t* pSource)
+{
+  if (0 != pSource)
+  {
+    sourceWait(pSource);
+
+    pSource->uiBlockLen = 0;
+    pSource->bFetch     = false;
+  }
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* readFrame_logical()                                                        */
+/* sourceWritable()                                                           */
 /*----------------------------------------------------------------------------*/
-static int readFrame_logical(readbuffer_t* pRead)
+bool sourceWritable(const source_t* pSource)
 {
-  int iReturn = 0;
+  return (0 != pSource) && (0 != pSource->pOps) && (0 != pSource->pOps->pfnWrite);
+}
 
-  const uint8_t* pSrc = zxn_memmap(pRead->uiAddr);
 
-  for (uint8_t i = 0; i < pRead->uiStride; ++i)
+/*----------------------------------------------------------------------------*/
+/* sourceWrite()                                                              */
+/*----------------------------------------------------------------------------*/
+int sourceWrite(source_t* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  if ((0 != pSource) && (0 != pSource->pOps) && (0 != pData))
   {
-    if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+    sourceWait(pSource);
+
+    if (0 != pSource->pOps->pfnWrite)
     {
-      pRead->uiData[i] = pSrc[i];
-      ++iReturn;
+      iReturn = pSource->pOps->pfnWrite(pSource, uiAddr, pData, uiLen);
     }
     else
     {
-      pRead->uiData[i] = 0;
+      iReturn = ENOTSUP;
     }
+
+    /* The buffers may hold the old data */
+    pSource->uiBlockLen = 0;
+    pSource->bFetch     = false;
+    g_uiWindowPos       = uiPOS_UNKNOWN;
+  }
+  else
+  {
+    iReturn = EINVAL;
   }
 
   return iReturn;
@@ -168,81 +540,952 @@ static int readFrame_logical(readbuffer_t* pRead)
 
 
 /*----------------------------------------------------------------------------*/
-/* readFrame_physical()                                                       */
+/* sourcePrefetch()                                                           */
 /*----------------------------------------------------------------------------*/
-static int readFrame_physical(readbuffer_t* pRead)
+int sourcePrefetch(source_t* pSource, const readbuffer_t* pRead)
 {
-  int iReturn = 0;
+  int iReturn = EOK;
+
+  if ((0 != pSource) && (0 != pSource->pOps) && (0 != pRead))
+  {
+    if (0 == pSource->pOps->pfnFetch)
+    {
+      iReturn = ENOTSUP;
+    }
+    else if ((!pSource->bFetch) && (0 != pSource->uiBlockLen))
+    {
+      uint32_t uiAddr = pSource->uiBlockAddr + pSource->uiBlockLen;
+      uint32_t uiEnd  = (uiAddr & ~((uint32_t) (uiBLOCK_SIZE - 1))) + uiBLOCK_SIZE;
+
+      if (uiEnd > pRead->uiUpper)
+      {
+        uiEnd = pRead->uiUpper;
+      }
+
+      if (uiAddr < uiEnd)
+      {
+        pSource->bFetchMmu = false;
+
+        if (EOK == (iReturn = pSource->pOps->pfnFetch(pSource, uiAddr, pSource->pFetch, (uint16_t) (uiEnd - uiAddr))))
+        {
+          pSource->uiFetchAddr = uiAddr;
+          pSource->uiFetchLen  = (uint16_t) (uiEnd - uiAddr);
+          pSource->bFetch      = true;
+        }
+      }
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
 
-  const uint8_t* pSrc = zxn_memmap(pRead->uiAddr);
+  return iReturn;
+}
 
-  /* TODO */
 
-  for (uint8_t i = 0; i < pRead->uiStride; ++i)
+/*----------------------------------------------------------------------------*/
+/* sourceWait()                                                               */
+/*----------------------------------------------------------------------------*/
+void sourceWait(source_t* pSource)
+{
+  if ((0 != pSource) && pSource->bFetch)
   {
-    if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+    while (zxn_dma_busy())
     {
-      pRead->uiData[i] = pSrc[i];
-      ++iReturn;
+      ;
     }
-    else
+
+    if (pSource->bFetchMmu)
+    {
+      bufferUnmap();
+      pSource->bFetchMmu = false;
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock()                                                                */
+/*----------------------------------------------------------------------------*/
+int readBlock(source_t* pSource, uint32_t uiAddr, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  if ((0 != pSource) && (0 != pSource->pOps) && (uiBLOCK_SIZE >= uiLen))
+  {
+    sourceWait(pSource);
+
+    pSource->uiBlockAddr = uiAddr;
+    pSource->uiBlockLen  = 0;
+
+    if (EOK == (iReturn = pSource->pOps->pfnRead(pSource, uiAddr, pSource->pBlock, uiLen)))
     {
-      pRead->uiData[i] = 0;
+      pSource->uiBlockLen = uiLen;
     }
   }
+  else
+  {
+    iReturn = EINVAL;
+  }
 
   return iReturn;
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* readFrame_file()                                                           */
+/* readFrame()                                                                */
 /*----------------------------------------------------------------------------*/
-static int readFrame_file(readbuffer_t* pRead, fileinfo_t* pFile)
+int readFrame(source_t* pSource, readbuffer_t* pRead)
 {
-  int iReturn = 0;
+  int iReturn = EOK;
 
-  if (INV_FILE_HND != pFile->hFile)
+  if ((0 != pSource) && (0 != pRead))
   {
-    for (uint8_t i = 0; i < pRead->uiStride; ++i)
+    uint8_t uiFrom = 0;
+    uint8_t uiTo   = 0;
+
+    /* Only the part of the frame within the bounds is valid */
+    if ((pRead->uiAddr < pRead->uiUpper) && ((pRead->uiAddr + pRead->uiStride) > pRead->uiLower))
+    {
+      uiFrom = (pRead->uiAddr < pRead->uiLower ? pRead->uiLower - pRead->uiAddr : 0);
+      uiTo   = ((pRead->uiAddr + pRead->uiStride) > pRead->uiUpper ?
+                pRead->uiUpper - pRead->uiAddr :
+                pRead->uiStride);
+    }
+
+    memset(pRead->uiData, 0, pRead->uiStride);
+
+    if (uiFrom < uiTo)
     {
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+      uint32_t uiFirst = pRead->uiAddr + uiFrom;
+      uint32_t uiLast  = pRead->uiAddr + uiTo;
+
+      /* Frame not buffered, but read in the background: take the block over */
+      if (pSource->bFetch &&
+          ((uiFirst < pSource->uiBlockAddr) ||
+           (uiLast > (pSource->uiBlockAddr + pSource->uiBlockLen))))
       {
-        if (UINT32_C(-1) != esx_f_seek(pFile->hFile, pRead->uiAddr + i, ESX_SEEK_SET))
+        sourceWait(pSource);
+
+        if ((uiFirst >= pSource->uiFetchAddr) &&
+            (uiLast <= (pSource->uiFetchAddr + pSource->uiFetchLen)))
         {
-          if (1 == esx_f_read(pFile->hFile, &pRead->uiData[i], 1))
-          {
-            ++iReturn;
-          }
-          else
-          {
-            iReturn = -1 * EBADF;
-            break;
-          }
+          uint8_t* pBlock = pSource->pBlock;
+
+          pSource->pBlock      = pSource->pFetch;
+          pSource->pFetch      = pBlock;
+          pSource->uiBlockAddr = pSource->uiFetchAddr;
+          pSource->uiBlockLen  = pSource->uiFetchLen;
         }
-        else
+
+        pSource->bFetch = false;
+      }
+
+      /* Frame not (completely) buffered: read the block containing it */
+      if ((uiFirst < pSource->uiBlockAddr) ||
+          (uiLast > (pSource->uiBlockAddr + pSource->uiBlockLen)))
+      {
+        uint32_t uiBlock = uiFirst & ~((uint32_t) (uiBLOCK_SIZE - 1));
+        uint32_t uiEnd   = uiBlock + uiBLOCK_SIZE;
+
+        if (uiBlock < pRead->uiLower)
         {
-          iReturn = -1 * EBADF;
-          break;
+          uiBlock = pRead->uiLower;
+        }
+
+        if (uiEnd > pRead->uiUpper)
+        {
+          uiEnd = pRead->uiUpper;
+        }
+
+        /* Frames never cross a block boundary (uiBLOCK_SIZE % stride == 0) */
+        if (uiLast > uiEnd)
+        {
+          uiBlock = uiFirst;
+          uiEnd   = uiLast;
         }
 
-        ++iReturn;
+        iReturn = readBlock(pSource, uiBlock, (uint16_t) (uiEnd - uiBlock));
       }
-      else
+
+      if (EOK == iReturn)
       {
-        pRead->uiData[i] = 0;
+        zxn_ldi(&pRead->uiData[uiFrom],
+                &pSource->pBlock[(uint16_t) (uiFirst - pSource->uiBlockAddr)],
+                uiTo - uiFrom);
       }
     }
   }
   else
   {
-    iReturn = -1 * ESTAT;
+    iReturn = EINVAL;
   }
 
   return iReturn;
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* openSource_memory()                                                        */
+/*----------------------------------------------------------------------------*/
+static int openSource_memory(source_t* pSource)
+{
+  (void) pSource;
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* closeSource_memory()                                                       */
+/*----------------------------------------------------------------------------*/
+static void closeSource_memory(source_t* pSource)
+{
+  (void) pSource;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock_logical()                                                        */
+/*----------------------------------------------------------------------------*/
+static int readBlock_logical(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  uint16_t uiSrc  = (uint16_t) uiAddr;
+  uint16_t uiPart = (uint16_t) (0 - uiSrc); /* Bytes up to the end of the 64K */
+
+  (void) pSource;
+
+  if ((0 == uiPart) || (uiPart > uiLen))
+  {
+    uiPart = uiLen;
+  }
+
+  zxn_memcpy(pData, zxn_memmap(uiSrc), uiPart);
+
+  if (uiPart < uiLen)
+  {
+    zxn_memcpy(&pData[uiPart], zxn_memmap(0), uiLen - uiPart);
+  }
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* fetchBlock_logical()                                                       */
+/*----------------------------------------------------------------------------*/
+static int fetchBlock_logical(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+  uint32_t uiSrc = uiAddr & UINT32_C(0xFFFF);
+
+  if ((uiSrc + uiLen) <= UINT32_C(0x10000))
+  {
+    /* Reads of 0xC000 - 0xDFFF depend on the page mapped into MMU6 */
+    pSource->bFetchMmu = (uiSrc < (uiPHYS_WINDOW + uiPHYS_PAGE_SIZE)) && ((uiSrc + uiLen) > uiPHYS_WINDOW);
+
+    zxn_dma_start(pData, zxn_memmap((uint16_t) uiSrc), uiLen);
+  }
+  else
+  {
+    iReturn = ENOTSUP;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* writeBlock_logical()                                                       */
+/*----------------------------------------------------------------------------*/
+static int writeBlock_logical(source_t* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen)
+{
+  uint16_t uiDst  = (uint16_t) uiAddr;
+  uint16_t uiPart = (uint16_t) (0 - uiDst); /* Bytes up to the end of the 64K */
+
+  (void) pSource;
+
+  if ((0 == uiPart) || (uiPart > uiLen))
+  {
+    uiPart = uiLen;
+  }
+
+  zxn_memcpy(zxn_memmap(uiDst), pData, uiPart);
+
+  if (uiPart < uiLen)
+  {
+    zxn_memcpy(zxn_memmap(0), &pData[uiPart], uiLen - uiPart);
+  }
+
+  return EOK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sizeSource_logical()                                                       */
+/*----------------------------------------------------------------------------*/
+static uint32_t sizeSource_logical(source_t* pSource)
+{
+  (void) pSource;
+  return UINT32_C(0x10000);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock_physical()                                                       */
+/*----------------------------------------------------------------------------*/
+static int readBlock_physical(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  (void) pSource;
+
+  if ((uiAddr + uiLen) <= uiPHYS_MEM_SIZE)
+  {
+    /* The 8K pages are mapped one by one into MMU6 (0xC000 - 0xDFFF) */
+
+    while (0 < uiLen)
+    {
+      uint16_t uiOfs  = (uint16_t) (uiAddr & (uiPHYS_PAGE_SIZE - 1));
+      uint16_t uiPart = uiPHYS_PAGE_SIZE - uiOfs;
+
+      if (uiPart > uiLen)
+      {
+        uiPart = uiLen;
+      }
+
+      zxn_memcpy(pData, bufferMapPage((uint8_t) (uiAddr >> 13)) + uiOfs, uiPart);
+
+      pData  += uiPart;
+      uiAddr += uiPart;
+      uiLen  -= uiPart;
+    }
+
+    bufferUnmap();
+  }
+  else
+  {
+    iReturn = ERANGE;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* fetchBlock_physical()                                                      */
+/*----------------------------------------------------------------------------*/
+static int fetchBlock_physical(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+  uint16_t uiOfs = (uint16_t) (uiAddr & (uiPHYS_PAGE_SIZE - 1));
+
+  if (((uiAddr + uiLen) <= uiPHYS_MEM_SIZE) && ((uiOfs + uiLen) <= uiPHYS_PAGE_SIZE))
+  {
+    /* The page stays mapped into MMU6 until the transfer is finished */
+    pSource->bFetchMmu = true;
+
+    zxn_dma_start(pData, bufferMapPage((uint8_t) (uiAddr >> 13)) + uiOfs, uiLen);
+  }
+  else
+  {
+    iReturn = ENOTSUP;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* writeBlock_physical()                                                      */
+/*----------------------------------------------------------------------------*/
+static int writeBlock_physical(source_t* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  (void) pSource;
+
+  if ((uiAddr + uiLen) <= uiPHYS_MEM_SIZE)
+  {
+    /* The 8K pages are mapped one by one into MMU6 (0xC000 - 0xDFFF) */
+
+    while (0 < uiLen)
+    {
+      uint16_t uiOfs  = (uint16_t) (uiAddr & (uiPHYS_PAGE_SIZE - 1));
+      uint16_t uiPart = uiPHYS_PAGE_SIZE - uiOfs;
+
+      if (uiPart > uiLen)
+      {
+        uiPart = uiLen;
+      }
+
+      zxn_memcpy(bufferMapPage((uint8_t) (uiAddr >> 13)) + uiOfs, pData, uiPart);
+
+      pData  += uiPart;
+      uiAddr += uiPart;
+      uiLen  -= uiPart;
+    }
+
+    bufferUnmap();
+  }
+  else
+  {
+    iReturn = ERANGE;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sizeSource_physical()                                                      */
+/*----------------------------------------------------------------------------*/
+static uint32_t sizeSource_physical(source_t* pSource)
+{
+  (void) pSource;
+  return uiPHYS_MEM_SIZE;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* openSource_file()                                                          */
+/*----------------------------------------------------------------------------*/
+static int openSource_file(source_t* pSource)
+{
+  int iReturn = EOK;
+
+  if ((0 == pSource->pFile) || (INV_FILE_HND == pSource->pFile->hFile))
+  {
+    iReturn = EBADF;
+  }
+  else if (pSource->pFile->bPacked)
+  {
+    pSource->pOps = &g_tPackedOps;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock_file()                                                           */
+/*----------------------------------------------------------------------------*/
+static int readBlock_file(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  fileinfo_t* pFile = pSource->pFile;
+  uint32_t    uiPos = uiAddr + pFile->uiBase;
+
+  if (bufferAvailable(BUFFER_READ))
+  {
+    /* The file is read in windows of 8K; the blocks are copied from the window */
+    while ((EOK == iReturn) && (0 < uiLen))
+    {
+      uint32_t uiWindow = uiPos & ~((uint32_t) (uiBUFFER_SIZE - 1));
+      uint16_t uiOfs    = (uint16_t) (uiPos - uiWindow);
+      uint16_t uiPart   = 0;
+
+      if (uiWindow != g_uiWindowPos)
+      {
+        g_uiWindowPos = uiPOS_UNKNOWN;
+
+        if (EOK == (iReturn = seekFile(pFile, uiWindow)))
+        {
+          g_uiWindowLen = esx_f_read(pFile->hFile, bufferMap(BUFFER_READ), uiBUFFER_SIZE);
+          bufferUnmap();
+
+          if (uiBUFFER_SIZE >= g_uiWindowLen)
+          {
+            g_uiWindowPos = uiWindow;
+            pFile->uiPos += g_uiWindowLen;
+          }
+          else
+          {
+            pFile->uiPos = uiPOS_UNKNOWN;
+            iReturn = EBADF;
+          }
+        }
+      }
+
+      if (EOK == iReturn)
+      {
+        if (g_uiWindowLen > uiOfs)
+        {
+          uiPart = ((g_uiWindowLen - uiOfs) > uiLen ? uiLen : g_uiWindowLen - uiOfs);
+
+          zxn_memcpy(pData, bufferMap(BUFFER_READ) + uiOfs, uiPart);
+          bufferUnmap();
+
+          pData += uiPart;
+          uiPos += uiPart;
+          uiLen -= uiPart;
+        }
+        else
+        {
+          iReturn = EBADF; /* Error: end of file */
+        }
+      }
+    }
+  }
+  else if (EOK == (iReturn = seekFile(pFile, uiPos)))
+  {
+    if (uiLen == esx_f_read(pFile->hFile, pData, uiLen))
+    {
+      pFile->uiPos += uiLen;
+    }
+    else
+    {
+      pFile->uiPos = uiPOS_UNKNOWN;
+      iReturn = EBADF;
+    }
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sizeSource_file()                                                          */
+/*----------------------------------------------------------------------------*/
+static uint32_t sizeSource_file(source_t* pSource)
+{
+  uint32_t uiReturn = 0;
+
+  struct esx_stat tStat;
+
+  if (0 == esx_f_fstat(pSource->pFile->hFile, &tStat))
+  {
+    uiReturn = tStat.size;
+  }
+
+  return uiReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* writeBlock_file()                                                          */
+/*----------------------------------------------------------------------------*/
+static int writeBlock_file(source_t* pSource, uint32_t uiAddr, const uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  fileinfo_t* pFile = pSource->pFile;
+
+  /* The read handles stay read-only; a second handle is used to write */
+  if (INV_FILE_HND == pFile->hWrite)
+  {
+    pFile->hWrite = esx_f_open(pFile->acPathName, ESX_MODE_WRITE | ESX_MODE_OPEN_EXIST);
+  }
+
+  if (INV_FILE_HND == pFile->hWrite)
+  {
+    iReturn = EACCES;
+  }
+  else if (UINT32_C(-1) == esx_f_seek(pFile->hWrite, uiAddr + pFile->uiBase, ESX_SEEK_SET))
+  {
+    iReturn = EBADF;
+  }
+  else if (uiLen != esx_f_write(pFile->hWrite, pData, uiLen))
+  {
+    iReturn = EBADF;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock_packed()                                                         */
+/*----------------------------------------------------------------------------*/
+static int readBlock_packed(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  return unpackRead(pSource->pFile, uiAddr + pSource->pFile->uiBase, pData, uiLen);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sizeSource_packed()                                                        */
+/*----------------------------------------------------------------------------*/
+static uint32_t sizeSource_packed(source_t* pSource)
+{
+  (void) pSource;
+  return unpackSize();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock_nextreg()                                                        */
+/*----------------------------------------------------------------------------*/
+static int readBlock_nextreg(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  (void) pSource;
+
+  if ((uiAddr + uiLen) <= uiNEXTREG_SIZE)
+  {
+    uint8_t uiReg = (uint8_t) uiAddr;
+
+    /* Select register (0x243B) and read it's value (0x253B) */
+    while (0 < uiLen--)
+    {
+      IO_NEXTREG_REG = uiReg++;
+      *pData++ = IO_NEXTREG_DAT;
+    }
+  }
+  else
+  {
+    iReturn = ERANGE;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sizeSource_nextreg()                                                       */
+/*----------------------------------------------------------------------------*/
+static uint32_t sizeSource_nextreg(source_t* pSource)
+{
+  (void) pSource;
+  return uiNEXTREG_SIZE;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock_palette()                                                        */
+/*----------------------------------------------------------------------------*/
+static int readBlock_palette(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  (void) pSource;
+
+  if ((uiAddr + uiLen) <= uiPALETTE_SIZE)
+  {
+    uint8_t  uiControl = ZXN_READ_REG(REG_PAL_CONTROL);
+    uint8_t  uiIndex   = ZXN_READ_REG(REG_PAL_INDEX);
+    uint8_t  uiSelect  = 0xFF;
+    uint16_t uiPos     = (uint16_t) uiAddr;
+
+    /* The index is not incremented by reading: each entry is selected */
+    while (0 < uiLen--)
+    {
+      if (uiSelect != (uint8_t) (uiPos >> 9))
+      {
+        uiSelect = (uint8_t) (uiPos >> 9);
+        ZXN_WRITE_REG(REG_PAL_CONTROL, (uiControl & 0x8F) | (uiSelect << 4));
+      }
+
+      ZXN_WRITE_REG(REG_PAL_INDEX, (uint8_t) (uiPos >> 1));
+      *pData++ = (0 == (uiPos & 1) ? ZXN_READ_REG(REG_PAL_VALUE8) : ZXN_READ_REG(REG_PAL_VALUE9));
+      ++uiPos;
+    }
+
+    ZXN_WRITE_REG(REG_PAL_CONTROL, uiControl);
+    ZXN_WRITE_REG(REG_PAL_INDEX, uiIndex);
+  }
+  else
+  {
+    iReturn = ERANGE;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sizeSource_palette()                                                       */
+/*----------------------------------------------------------------------------*/
+static uint32_t sizeSource_palette(source_t* pSource)
+{
+  (void) pSource;
+  return uiPALETTE_SIZE;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock_tilemap()                                                        */
+/*----------------------------------------------------------------------------*/
+static int readBlock_tilemap(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  if ((uiAddr + uiLen) <= sizeSource_tilemap(pSource))
+  {
+    uint8_t  uiBase = ZXN_READ_REG(REG_TM_BASE);
+    uint32_t uiPhys = (0 != (uiBase & 0x80) ? uiPHYS_BANK_7 : uiPHYS_BANK_5);
+
+    uiPhys += ((uint32_t) (uiBase & 0x3F)) << 8;
+
+    iReturn = readBlock_physical(pSource, uiPhys + uiAddr, pData, uiLen);
+  }
+  else
+  {
+    iReturn = ERANGE;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sizeSource_tilemap()                                                       */
+/*----------------------------------------------------------------------------*/
+static uint32_t sizeSource_tilemap(source_t* pSource)
+{
+  uint8_t  uiControl = ZXN_READ_REG(REG_TM_CONTROL);
+  uint32_t uiReturn  = (0 != (uiControl & 0x40) ? UINT32_C(80 * 32) : UINT32_C(40 * 32));
+
+  (void) pSource;
+
+  /* Without attributes an entry is one byte, else two bytes */
+  return (0 != (uiControl & 0x20) ? uiReturn : uiReturn << 1);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* openSource_disk()                                                          */
+/*----------------------------------------------------------------------------*/
+static int openSource_disk(source_t* pSource)
+{
+  int iReturn = EOK;
+
+  if (0 != pSource->pFile)
+  {
+    g_uiSectorNo = uiPOS_UNKNOWN;
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readBlock_disk()                                                           */
+/*----------------------------------------------------------------------------*/
+static int readBlock_disk(source_t* pSource, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  /* The cache buffer holds 16 sectors, else one sector is buffered */
+  bool     bCache    = bufferAvailable(BUFFER_CACHE);
+  uint16_t uiSectors = (bCache ? uiBUFFER_SIZE / uiSECTOR_SIZE : 1);
+
+  while ((EOK == iReturn) && (0 < uiLen))
+  {
+    uint32_t uiSectorNo = (uiAddr >> 9) & ~((uint32_t) (uiSectors - 1));
+    uint16_t uiOfs      = (uint16_t) (uiAddr - (uiSectorNo << 9));
+    uint16_t uiPart     = (uiSectors * uiSECTOR_SIZE) - uiOfs;
+    uint8_t* pBuffer    = (bCache ? bufferMap(BUFFER_CACHE) : g_uiSector);
+
+    /* Each sector is read once, all blocks within are copied from the buffer */
+    if (uiSectorNo != g_uiSectorNo)
+    {
+      g_uiSectorNo = uiPOS_UNKNOWN;
+
+      for (uint16_t i = 0; i < uiSectors; ++i)
+      {
+        if (0 != esx_disk_read(pSource->pFile->uiDevice, uiSectorNo + i, &pBuffer[i * uiSECTOR_SIZE]))
+        {
+          iReturn = EBADF;
+          break;
+        }
+      }
+
+      if (EOK == iReturn)
+      {
+        g_uiSectorNo = uiSectorNo;
+      }
+    }
+
+    if (EOK == iReturn)
+    {
+      if (uiPart > uiLen)
+      {
+        uiPart = uiLen;
+      }
+
+      zxn_memcpy(pData, &pBuffer[uiOfs], uiPart);
+
+      pData  += uiPart;
+      uiAddr += uiPart;
+      uiLen  -= uiPart;
+    }
+
+    bufferUnmap();
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* sizeSource_disk()                                                          */
+/*----------------------------------------------------------------------------*/
+static uint32_t sizeSource_disk(source_t* pSource)
+{
+  (void) pSource;
+  return UINT32_C(0xFFFFFFFF);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* seekFile()                                                                 */
+/*----------------------------------------------------------------------------*/
+static int seekFile(fileinfo_t* pFile, uint32_t uiTarget)
+{
+  int iReturn = EOK;
+
+  if (uiTarget != pFile->uiPos) /* Sequential access: no seek required */
+  {
+    /* Backward or long jump: continue at the nearest checkpoint below */
+    if ((uiTarget < pFile->uiPos) || ((uiTarget - pFile->uiPos) > uiCHECK_GAP))
+    {
+      checkpoint_t* pBest = 0;
+      checkpoint_t* pLow  = 0;
+
+      for (uint8_t i = 0; i < uiMAX_CHECKPOINTS; ++i)
+      {
+        checkpoint_t* pCheck = &pFile->tCheck[i];
+
+        if (INV_FILE_HND != pCheck->hFile)
+        {
+          if ((pCheck->uiPos <= uiTarget) &&
+              ((pFile->uiPos > uiTarget) || (pCheck->uiPos > pFile->uiPos)) &&
+              ((0 == pBest) || (pCheck->uiPos > pBest->uiPos)))
+          {
+            pBest = pCheck;
+          }
+
+          if ((0 == pLow) || (pCheck->uiPos < pLow->uiPos))
+          {
+            pLow = pCheck;
+          }
+        }
+      }
+
+      /* Restart from the beginning with the least useful checkpoint */
+      if ((0 == pBest) && (uiTarget < pFile->uiPos))
+      {
+        pBest = pLow;
+      }
+
+      /* Swap handles: the current position is kept as checkpoint */
+      if (0 != pBest)
+      {
+        checkpoint_t tCurrent = {pFile->hFile, pFile->uiPos};
+
+        pFile->hFile  = pBest->hFile;
+        pFile->uiPos  = pBest->uiPos;
+        *pBest        = tCurrent;
+      }
+    }
+
+    if ((uiPOS_UNKNOWN != pFile->uiPos) && (uiTarget >= pFile->uiPos))
+    {
+      if (UINT32_C(-1) == esx_f_seek(pFile->hFile, uiTarget - pFile->uiPos, ESX_SEEK_FWD))
+      {
+        iReturn = EBADF;
+      }
+    }
+    else
+    {
+      if (UINT32_C(-1) == esx_f_seek(pFile->hFile, uiTarget, ESX_SEEK_SET))
+      {
+        iReturn = EBADF;
+      }
+    }
+
+    pFile->uiPos = (EOK == iReturn ? uiTarget : uiPOS_UNKNOWN);
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* openFile()                                                                 */
+/*----------------------------------------------------------------------------*/
+int openFile(fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if (0 != pFile)
+  {
+    pFile->uiPos   = 0;
+    pFile->bPacked = false;
+    pFile->hWrite  = INV_FILE_HND;
+
+    g_uiWindowPos = uiPOS_UNKNOWN;
+
+    if (INV_FILE_HND != (pFile->hFile = esx_f_open(pFile->acPathName, ESX_MODE_READ | ESX_MODE_OPEN_EXIST)))
+    {
+      /* Checkpoints are optional; they are not used, if no handle is left */
+      for (uint8_t i = 0; i < uiMAX_CHECKPOINTS; ++i)
+      {
+        pFile->tCheck[i].hFile = esx_f_open(pFile->acPathName, ESX_MODE_READ | ESX_MODE_OPEN_EXIST);
+        pFile->tCheck[i].uiPos = 0;
+      }
+    }
+    else
+    {
+      iReturn = EBADF;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* closeFile()                                                                */
+/*----------------------------------------------------------------------------*/
+void closeFile(fileinfo_t* pFile)
+{
+  if (0 != pFile)
+  {
+    if (pFile->bPacked)
+    {
+      unpackClose();
+      pFile->bPacked = false;
+    }
+
+    for (uint8_t i = 0; i < uiMAX_CHECKPOINTS; ++i)
+    {
+      if (INV_FILE_HND != pFile->tCheck[i].hFile)
+      {
+        (void) esx_f_close(pFile->tCheck[i].hFile);
+        pFile->tCheck[i].hFile = INV_FILE_HND;
+      }
+    }
+
+    if (INV_FILE_HND != pFile->hFile)
+    {
+      /* The write handle belongs to a file opened by "openFile()" */
+      if (INV_FILE_HND != pFile->hWrite)
+      {
+        (void) esx_f_close(pFile->hWrite);
+        pFile->hWrite = INV_FILE_HND;
+      }
+
+      (void) esx_f_close(pFile->hFile);
+      pFile->hFile = INV_FILE_HND;
+    }
+
+    g_uiWindowPos = uiPOS_UNKNOWN;
+  }
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
@@ -52,6 +52,30 @@
 /*============================================================================*/
 /*                               Defines                                      */
 /*============================================================================*/
+/*!
+Opcodes of the format programs
+*/
+#define uiOP_END     (0)  /* End of the line                                  */
+#define uiOP_TEXT    (1)  /* Literal text: <count> <chars...>                 */
+#define uiOP_ADDR    (2)  /* Address of the frame                             */
+
+/*!
+Opcodes of the format programs, that render the data of the frame: <op> <param>
+(index + uiOP_HEX in the table of data operations)
+*/
+#define uiOP_HEX     (3)  /* Bytes in hex: <bytes per group> (0 = no groups)  */
+#define uiOP_CHAR    (4)  /* Bytes as ASCII characters                        */
+#define uiOP_BIN     (5)  /* Bytes in binary                                  */
+#define uiOP_OCT     (6)  /* Bytes in octal                                   */
+#define uiOP_DEC     (7)  /* Bytes in decimal                                 */
+#define uiOP_HEX16   (8)  /* 16 bit words in hex, little endian               */
+#define uiOP_HEX16BE (9)  /* 16 bit words in hex, big endian                  */
+#define uiOP_HEX32   (10) /* 32 bit words in hex, little endian               */
+#define uiOP_HEX32BE (11) /* 32 bit words in hex, big endian                  */
+#define uiOP_DEC16   (12) /* 16 bit words in decimal, little endian           */
+#define uiOP_DEC16BE (13) /* 16 bit words in decimal, big endian              */
+#define uiOP_DEC32   (14) /* 32 bit words in decimal, little endian           */
+#define uiOP_DEC32BE (15) /* 32 bit words in decimal, big endian              */
 
 /*============================================================================*/
 /*                               Namespaces                                   */
@@ -72,57 +96,160 @@
 /*============================================================================*/
 /*                               Typ-Definitionen                             */
 /*============================================================================*/
+/*!
+Function to render the address of a frame
+*/
+typedef uint8_t (*addrfn_t)(uint32_t, char_t*);
+
+struct _dataop;
+
+/*!
+Function to render the data of a frame
+*/
+typedef char_t* (*datafn_t)(const struct _dataop*, uint8_t, const readbuffer_t*, uint8_t, uint8_t, char_t*);
+
+/*!
+Data operation of the format programs
+*/
+typedef struct _dataop
+{
+  /*!
+  Renderer of the operation
+  */
+  datafn_t pfnRender;
+
+  /*!
+  Number of bytes per item (byte, word, long)
+  */
+  uint8_t uiSize;
+
+  /*!
+  Number of characters per item
+  */
+  uint8_t uiWidth;
+
+  /*!
+  Number of characters between the items
+  */
+  uint8_t uiSep;
+
+  /*!
+  Byte order of the items: "false" = little endian; "true" = big endian
+  */
+  bool bBigEndian;
+} dataop_t;
+
+/*!
+Index of the layouts in the table of layouts
+*/
+typedef enum _layout
+{
+  LAYOUT_85 = 0,
+  LAYOUT_80,
+  LAYOUT_64,
+  LAYOUT_32,
+  LAYOUT_64_WIDE,
+  LAYOUT_32_WIDE
+} layout_t;
 
 /*============================================================================*/
 /*                               Prototypen                                   */
 /*============================================================================*/
 /*!
-This function renders a dataframe in 85 column mode.
-@param uiIdx Current index in the render buffer
-@param pRead Pointer to the read buffer
+This function calculates the columns of the hex and ASCII representation and
+the length of a line of a compiled format program.
+@param pRead Pointer to the read buffer (stride)
 @param pRender Pointer to the render buffer
-@return Current index in the render buffer
+@return EOK = no error; ERANGE = line is longer than the render buffer
 */
-static uint16_t renderFrame_85(
-  uint16_t uiIdx,
-  const readbuffer_t* pRead,
-  renderbuffer_t* pRender);
+static int measureProgram(const readbuffer_t* pRead, renderbuffer_t* pRender);
 
 /*!
-This function renders a dataframe in 80 column mode (write to file).
-@param uiIdx Current index in the render buffer
+This function renders the bytes of a frame in hex.
+@param pOp Pointer to the data operation
+@param uiParam Bytes per group (0 = no groups)
 @param pRead Pointer to the read buffer
-@param pRender Pointer to the render buffer
-@return Current index in the render buffer
+@param uiFrom Index of the first byte within the bounds of the region
+@param uiTo Index behind the last byte within the bounds of the region
+@param acIdx Current position in the render buffer
+@return New position in the render buffer
 */
-static uint16_t renderFrame_80(
-  uint16_t uiIdx,
-  const readbuffer_t* pRead,
-  renderbuffer_t* pRender);
+static char_t* renderData_hex(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx);
 
 /*!
-This function renders a dataframe in 64 column mode.
-@param uiIdx Current index in the render buffer
-@param pRead Pointer to the read buffer
-@param pRender Pointer to the render buffer
-@return Current index in the render buffer
+This function renders the bytes of a frame as ASCII characters.
+(Parameters: see "renderData_hex()")
 */
-static uint16_t renderFrame_64(
-  uint16_t uiIdx,
-  const readbuffer_t* pRead,
-  renderbuffer_t* pRender);
+static char_t* renderData_char(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx);
 
 /*!
-This function renders a dataframe in 32 column mode.
-@param uiIdx Current index in the render buffer
-@param pRead Pointer to the read buffer
-@param pRender Pointer to the render buffer
-@return Current index in the render buffer
+This function renders the bytes of a frame in binary (8 digits per byte).
+(Parameters: see "renderData_hex()")
 */
-static uint16_t renderFrame_32(
-  uint16_t uiIdx,
-  const readbuffer_t* pRead,
-  renderbuffer_t* pRender);
+static char_t* renderData_bin(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx);
+
+/*!
+This function renders the bytes of a frame in octal (3 digits per byte).
+(Parameters: see "renderData_hex()")
+*/
+static char_t* renderData_oct(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx);
+
+/*!
+This function renders the bytes of a frame in decimal (3 digits per byte).
+(Parameters: see "renderData_hex()")
+*/
+static char_t* renderData_dec8(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx);
+
+/*!
+This function renders the 16 bit words of a frame in decimal.
+(Parameters: see "renderData_hex()")
+*/
+static char_t* renderData_dec16(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx);
+
+/*!
+This function renders the 32 bit words of a frame in decimal.
+(Parameters: see "renderData_hex()")
+*/
+static char_t* renderData_dec32(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx);
+
+/*!
+This function renders the 16 or 32 bit words of a frame in hex.
+(Parameters: see "renderData_hex()")
+*/
+static char_t* renderData_word(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx);
+
+/*!
+This function renders a 24 bit address (6 digits).
+@param uiAddr Address to render
+@param acHex Pointer to the render buffer
+@return Number of rendered characters
+*/
+static uint8_t renderAddr_24(uint32_t uiAddr, char_t* acHex);
+
+/*!
+This function renders a 32 bit address (8 digits).
+@param uiAddr Address to render
+@param acHex Pointer to the render buffer
+@return Number of rendered characters
+*/
+static uint8_t renderAddr_32(uint32_t uiAddr, char_t* acHex);
+
+/*!
+This function renders an unsigned value in decimal (without leading zeros).
+@param uiValue Value to render
+@param acText Pointer to the render buffer (10 characters)
+@return Number of rendered characters
+*/
+static uint8_t renderDecimal(uint32_t uiValue, char_t* acText);
+
+/*!
+This function renders an IEEE 754 single precision value (integer arithmetic
+only; 7 significant digits or "d.ddde+dd").
+@param uiBits Bits of the value
+@param acText Pointer to the render buffer (10 characters)
+@return Number of rendered characters
+*/
+static uint8_t renderFloat(uint32_t uiBits, char_t* acText);
 
 /*============================================================================*/
 /*                               Klassen                                      */
@@ -131,11 +258,208 @@ static uint16_t renderFrame_32(
 /*============================================================================*/
 /*                               Implementierung                              */
 /*============================================================================*/
+/*!
+Format of all built-in layouts (index: layout_t)
+*/
+static const char_t* const g_acLayout[] =
+{
+  "%a| %1x| %c",   /* LAYOUT_85:      "AAAAAA| XX XX ...| ..." (+ decode) */
+  "%a | %1x | %c", /* LAYOUT_80:      "AAAAAA | XX XX ... | ..." */
+  "%a|%2x |%c",    /* LAYOUT_64:      "AAAAAA|XXXX XXXX ... |..." */
+  "%a|%x|%c",      /* LAYOUT_32:      "AAAAAA|XXXX...|..."        */
+  "%a|%4x|%c",     /* LAYOUT_64_WIDE: "AAAAAAAA|XXXXXXXX ...|..." */
+  "%a|%4x"         /* LAYOUT_32_WIDE: "AAAAAAAA|XXXXXXXX ..."     */
+};
+
+/*!
+Table of all address formats (index: renderbuffer_t::uiAddrFmt)
+*/
+static const addrfn_t g_pfnAddr[] =
+{
+  renderAddr_24,
+  renderAddr_32
+};
+
+/*!
+Width of the address formats (index: renderbuffer_t::uiAddrFmt)
+*/
+static const uint8_t g_uiAddrLen[] = {6, 8};
+
+/*!
+Table of all data operations (index: opcode - uiOP_HEX)
+*/
+static const dataop_t g_tDataOp[] =
+{
+  {renderData_hex,   1,  2, 0, false}, /* uiOP_HEX     */
+  {renderData_char,  1,  1, 0, false}, /* uiOP_CHAR    */
+  {renderData_bin,   1,  8, 1, false}, /* uiOP_BIN     */
+  {renderData_oct,   1,  3, 1, false}, /* uiOP_OCT     */
+  {renderData_dec8,  1,  3, 1, false}, /* uiOP_DEC     */
+  {renderData_word,  2,  4, 1, false}, /* uiOP_HEX16   */
+  {renderData_word,  2,  4, 1, true},  /* uiOP_HEX16BE */
+  {renderData_word,  4,  8, 1, false}, /* uiOP_HEX32   */
+  {renderData_word,  4,  8, 1, true},  /* uiOP_HEX32BE */
+  {renderData_dec16, 2,  5, 1, false}, /* uiOP_DEC16   */
+  {renderData_dec16, 2,  5, 1, true},  /* uiOP_DEC16BE */
+  {renderData_dec32, 4, 10, 1, false}, /* uiOP_DEC32   */
+  {renderData_dec32, 4, 10, 1, true}   /* uiOP_DEC32BE */
+};
+
+/*!
+Size qualifiers of the conversions "%x" and "%d" (index + 1: offset of the
+opcode to uiOP_HEX16 resp. uiOP_DEC16)
+*/
+static const char_t g_acQualifier[] = "hHlL";
+
+/*!
+Labels of the items of the decode panel (every second row of the panel)
+*/
+static const char_t* const g_acDecodeLabel[] =
+{
+  "uint16 LE",
+  "uint16 BE",
+  "uint32 LE",
+  "uint32 BE",
+  "float",
+  "address"
+};
+
+/*!
+Number of bytes required to decode the items of the decode panel
+*/
+static const uint8_t g_uiDecodeSize[] = {2, 2, 4, 4, 4, 0};
 
 /*----------------------------------------------------------------------------*/
-/* renderFrame()                                                              */
+/* renderCompile()                                                            */
 /*----------------------------------------------------------------------------*/
-int renderFrame(
+int renderCompile(const char_t* acFormat, renderbuffer_t* pRender)
+{
+  int iReturn = EOK;
+
+  if ((0 != acFormat) && (0 != pRender))
+  {
+    uint8_t* pOp   = pRender->uiProgram;
+    uint8_t* pEnd  = &pRender->uiProgram[sizeof(pRender->uiProgram) - 1]; /* uiOP_END */
+    uint8_t* pText = 0; /* Count of the current text operation */
+
+    while ((EOK == iReturn) && ('\0' != *acFormat))
+    {
+      char_t cChar = *acFormat++;
+
+      if ('%' == cChar)
+      {
+        uint8_t     uiGroup = 0;
+        bool        bGroup  = false;
+        const char_t* pQual = 0;
+        uint8_t     uiOp    = uiOP_END;
+
+        if (between_uint8(*acFormat, '0', '9'))
+        {
+          uiGroup = (uint8_t) (*acFormat++ - '0');
+          bGroup  = true;
+        }
+
+        if (('\0' != *acFormat) && (0 != (pQual = strchr(g_acQualifier, *acFormat))))
+        {
+          ++acFormat;
+        }
+
+        if ('\0' == (cChar = *acFormat))
+        {
+          iReturn = EINVAL;
+          break;
+        }
+
+        ++acFormat;
+
+        if ('%' != cChar)
+        {
+          switch (cChar)
+          {
+            case 'x':
+              uiOp = (0 != pQual ? uiOP_HEX16 + (uint8_t) (pQual - g_acQualifier) : uiOP_HEX);
+              break;
+
+            case 'd':
+              uiOp = (0 != pQual ? uiOP_DEC16 + (uint8_t) (pQual - g_acQualifier) : uiOP_DEC);
+              break;
+
+            case 'a': uiOp = uiOP_ADDR; break;
+            case 'c': uiOp = uiOP_CHAR; break;
+            case 'b': uiOp = uiOP_BIN;  break;
+            case 'o': uiOp = uiOP_OCT;  break;
+            default:                    break;
+          }
+
+          /* Groups for "%x" only, qualifiers for "%x" and "%d" only */
+          if ((uiOP_END == uiOp) ||
+              (bGroup && (uiOP_HEX != uiOp)) ||
+              ((0 != pQual) && ('x' != cChar) && ('d' != cChar)))
+          {
+            iReturn = EINVAL;
+          }
+          else if ((pOp + 2) > pEnd)
+          {
+            iReturn = ERANGE;
+          }
+          else
+          {
+            *pOp++ = uiOp;
+
+            if (uiOP_HEX <= uiOp)
+            {
+              *pOp++ = uiGroup;
+            }
+          }
+
+          pText = 0;
+          continue;
+        }
+      }
+
+      /* Literal character: append to the current text operation */
+      if ((0 == pText) || (0xFF == *pText))
+      {
+        if ((pOp + 3) > pEnd)
+        {
+          iReturn = ERANGE;
+          break;
+        }
+
+        *pOp++ = uiOP_TEXT;
+        pText  = pOp++;
+        *pText = 0;
+      }
+      else if ((pOp + 1) > pEnd)
+      {
+        iReturn = ERANGE;
+        break;
+      }
+
+      ++(*pText);
+      *pOp++ = (uint8_t) cChar;
+    }
+
+    *pOp = uiOP_END;
+
+    if (EOK != iReturn)
+    {
+      pRender->uiProgram[0] = uiOP_END;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderSetup()                                                              */
+/*----------------------------------------------------------------------------*/
+int renderSetup(
   const screeninfo_t* pScreen,
   const readbuffer_t* pRead,
   renderbuffer_t* pRender)
@@ -144,37 +468,33 @@ int renderFrame(
 
   if ((0 != pScreen) && (0 != pRead) && (0 != pRender))
   {
-    char_t* acIdx = &pRender->acData[0];
+    bool bWide = (pRead->uiEnd > uiMAX_ADDR_24);
+    layout_t eLayout;
 
-   #if defined(__DEBUG__)
-    memset(pRender->acData, 0, sizeof(pRender->acData));
-   #endif
-
-    byte2hex((pRead->uiAddr >> 16) & 0xFF, acIdx); acIdx += 2;
-    byte2hex((pRead->uiAddr >>  8) & 0xFF, acIdx); acIdx += 2;
-    byte2hex((pRead->uiAddr >>  0) & 0xFF, acIdx); acIdx += 2;
+    pRender->uiAddrFmt = (bWide ? 1 : 0);
 
     if (85 <= pScreen->uiCols) /* 85 x 24 */
     {
-      acIdx += renderFrame_85(acIdx - pRender->acData, pRead, pRender);
+      eLayout = LAYOUT_85;
     }
     else if (80 <= pScreen->uiCols) /* 80 x X (file) */
     {
-      acIdx += renderFrame_80(acIdx - pRender->acData, pRead, pRender);
+      eLayout = LAYOUT_80;
     }
     else if (64 <= pScreen->uiCols) /* 64 x 24 */
     {
-      acIdx += renderFrame_64(acIdx - pRender->acData, pRead, pRender);
+      eLayout = (bWide ? LAYOUT_64_WIDE : LAYOUT_64);
     }
     else /* 32 x 24 */
     {
-      acIdx += renderFrame_32(acIdx - pRender->acData, pRead, pRender);
+      eLayout = (bWide ? LAYOUT_32_WIDE : LAYOUT_32);
     }
 
-    *acIdx = '\0';
-
-    pRender->uiLen = (uint8_t) (acIdx - pRender->acData);
-    iReturn = EOK;
+    /* A user defined format replaces the layout of the screen */
+    if (EOK == (iReturn = renderCompile(0 != pRender->acFormat ? pRender->acFormat : g_acLayout[eLayout], pRender)))
+    {
+      iReturn = measureProgram(pRead, pRender);
+    }
   }
 
   return iReturn;
@@ -182,228 +502,760 @@ int renderFrame(
 
 
 /*----------------------------------------------------------------------------*/
-/* renderFrame_85()                                                           */
+/* renderFrame()                                                              */
 /*----------------------------------------------------------------------------*/
-static uint16_t renderFrame_85(
-  uint16_t uiIdx,
+int renderFrame(
+  const screeninfo_t* pScreen,
   const readbuffer_t* pRead,
   renderbuffer_t* pRender)
 {
-  uint16_t uiReturn = 0;
+  int iReturn = EINVAL;
 
-  if ((0 != pRead) && (0 != pRender))
+  if ((0 != pScreen) && (0 != pRead) && (0 != pRender))
   {
-    char_t* acBegin = &pRender->acData[uiIdx];
-    char_t* acIdx   = acBegin;
+    const uint8_t* pOp   = pRender->uiProgram;
+    char_t*        acIdx = &pRender->acData[0];
+    uint8_t        uiFrom = 0;
+    uint8_t        uiTo   = 0;
+    uint8_t        uiCount;
 
-    *acIdx++ = ' '; /* * */
-    *acIdx++ = cSEPERATOR_CHAR;
+   #if defined(__DEBUG__)
+    memset(pRender->acData, 0, sizeof(pRender->acData));
+   #endif
 
-    for (uint8_t i = 0; i < pRead->uiStride; ++i)
+    /* Only the part of the frame within the bounds is shown */
+    if ((pRead->uiAddr < pRead->uiUpper) && ((pRead->uiAddr + pRead->uiStride) > pRead->uiLower))
     {
-      *acIdx++ = ' ';
+      uiFrom = (pRead->uiAddr < pRead->uiLower ? pRead->uiLower - pRead->uiAddr : 0);
+      uiTo   = ((pRead->uiAddr + pRead->uiStride) > pRead->uiUpper ?
+                pRead->uiUpper - pRead->uiAddr :
+                pRead->uiStride);
+    }
 
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
-      {
-        byte2hex(pRead->uiData[i], acIdx); 
-        acIdx += 2;
-      }
-      else
+    while (uiOP_END != *pOp)
+    {
+      switch (*pOp++)
       {
-        *acIdx++ = ' ';
-        *acIdx++ = ' ';
+        case uiOP_TEXT:
+          uiCount = *pOp++;
+
+          while (0 < uiCount--)
+          {
+            *acIdx++ = (char_t) *pOp++;
+          }
+          break;
+
+        case uiOP_ADDR:
+          acIdx += g_pfnAddr[pRender->uiAddrFmt](pRead->uiAddr, acIdx);
+          break;
+
+        default:
+          /* Data operation: one specialized loop over the whole frame */
+          acIdx = g_tDataOp[pOp[-1] - uiOP_HEX].pfnRender(&g_tDataOp[pOp[-1] - uiOP_HEX], *pOp, pRead, uiFrom, uiTo, acIdx);
+          ++pOp;
+          break;
       }
     }
 
-    *acIdx++ = ' '; /* * */
-    *acIdx++ = cSEPERATOR_CHAR;
-    *acIdx++ = ' ';
+    *acIdx = '\0';
+
+    pRender->uiLen = (uint8_t) (acIdx - pRender->acData);
+    iReturn = EOK;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* measureProgram()                                                           */
+/*----------------------------------------------------------------------------*/
+static int measureProgram(const readbuffer_t* pRead, renderbuffer_t* pRender)
+{
+  int iReturn = EOK;
+
+  const uint8_t* pOp   = pRender->uiProgram;
+  uint16_t       uiCol = 0;
+
+  pRender->uiHexCol   = uiNO_COLUMN;
+  pRender->uiHexGroup = 0;
+  pRender->uiCharCol  = uiNO_COLUMN;
 
-    for (uint8_t i = 0; i < pRead->uiStride; ++i)
+  while (uiOP_END != *pOp)
+  {
+    switch (*pOp++)
     {
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
-      {
-        *acIdx++ = (between_uint8(pRead->uiData[i], cFIRST_CHAR, cLAST_CHAR) ? pRead->uiData[i] : '.');
-      }
-      else
+      case uiOP_TEXT:
+        uiCol += *pOp;
+        pOp   += *pOp + 1;
+        break;
+
+      case uiOP_ADDR:
+        uiCol += g_uiAddrLen[pRender->uiAddrFmt];
+        break;
+
+      default:
       {
-        *acIdx++ = ' ';
+        const dataop_t* pData  = &g_tDataOp[pOp[-1] - uiOP_HEX];
+        uint8_t         uiItems = pRead->uiStride / pData->uiSize;
+
+        if ((uiOP_HEX == pOp[-1]) && (uiNO_COLUMN == pRender->uiHexCol))
+        {
+          pRender->uiHexCol   = (uint8_t) uiCol;
+          pRender->uiHexGroup = *pOp;
+        }
+        else if ((uiOP_CHAR == pOp[-1]) && (uiNO_COLUMN == pRender->uiCharCol))
+        {
+          pRender->uiCharCol = (uint8_t) uiCol;
+        }
+
+        uiCol += (uiItems * pData->uiWidth) + ((uiItems - 1) * pData->uiSep);
+
+        /* Separators between the groups of hex bytes */
+        if ((uiOP_HEX == pOp[-1]) && (0 != *pOp))
+        {
+          uiCol += (pRead->uiStride - 1) / *pOp;
+        }
+
+        ++pOp;
+        break;
       }
     }
+  }
 
-    uiReturn = (uint16_t) (acIdx - acBegin);
+  if (uiCol >= sizeof(pRender->acData))
+  {
+    iReturn = ERANGE;
   }
 
-  return uiReturn;
+  return iReturn;
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* renderFrame_80()                                                           */
+/* renderData_hex()                                                           */
 /*----------------------------------------------------------------------------*/
-static uint16_t renderFrame_80(
-  uint16_t uiIdx,
-  const readbuffer_t* pRead,
-  renderbuffer_t* pRender)
+static char_t* renderData_hex(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx)
+{
+  /* Separator in front of each group; 0xFF: never within a frame */
+  uint8_t uiCount = (0 != uiParam ? uiParam : 0xFF);
+
+  (void) pOp;
+
+  for (uint8_t i = 0; i < pRead->uiStride; ++i)
+  {
+    if (0 == uiCount)
+    {
+      *acIdx++ = ' ';
+      uiCount  = uiParam;
+    }
+
+    if ((uiFrom <= i) && (i < uiTo))
+    {
+      byte2hex(pRead->uiData[i], acIdx);
+    }
+    else
+    {
+      acIdx[0] = ' ';
+      acIdx[1] = ' ';
+    }
+
+    acIdx += 2;
+    --uiCount;
+  }
+
+  return acIdx;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderData_char()                                                          */
+/*----------------------------------------------------------------------------*/
+static char_t* renderData_char(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx)
 {
-  uint16_t uiReturn = 0;
+  (void) pOp;
+  (void) uiParam;
 
-  if ((0 != pRead) && (0 != pRender))
+  for (uint8_t i = 0; i < pRead->uiStride; ++i)
   {
-    char_t* acBegin = &pRender->acData[uiIdx];
-    char_t* acIdx   = acBegin;
+    if ((uiFrom <= i) && (i < uiTo))
+    {
+      *acIdx++ = (between_uint8(pRead->uiData[i], cFIRST_CHAR, cLAST_CHAR) ? pRead->uiData[i] : '.');
+    }
+    else
+    {
+      *acIdx++ = ' ';
+    }
+  }
 
-    *acIdx++ = ' ';
-    *acIdx++ = cSEPERATOR_CHAR;
-    *acIdx++ = ' ';
+  return acIdx;
+}
 
-    for (uint8_t i = 0; i < pRead->uiStride; ++i)
+
+/*----------------------------------------------------------------------------*/
+/* renderData_bin()                                                           */
+/*----------------------------------------------------------------------------*/
+static char_t* renderData_bin(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx)
+{
+  (void) pOp;
+  (void) uiParam;
+
+  for (uint8_t i = 0; i < pRead->uiStride; ++i)
+  {
+    if (0 != i)
     {
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+      *acIdx++ = ' ';
+    }
+
+    if ((uiFrom <= i) && (i < uiTo))
+    {
+      uint8_t uiVal = pRead->uiData[i];
+
+      for (uint8_t j = 0; j < 8; ++j, uiVal <<= 1)
       {
-        byte2hex(pRead->uiData[i], acIdx); 
-        acIdx += 2;
+        *acIdx++ = (0 != (uiVal & 0x80) ? '1' : '0');
       }
-      else
+    }
+    else
+    {
+      memset(acIdx, ' ', 8);
+      acIdx += 8;
+    }
+  }
+
+  return acIdx;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderData_oct()                                                           */
+/*----------------------------------------------------------------------------*/
+static char_t* renderData_oct(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx)
+{
+  (void) pOp;
+  (void) uiParam;
+
+  for (uint8_t i = 0; i < pRead->uiStride; ++i)
+  {
+    if (0 != i)
+    {
+      *acIdx++ = ' ';
+    }
+
+    if ((uiFrom <= i) && (i < uiTo))
+    {
+      uint8_t uiVal = pRead->uiData[i];
+
+      acIdx[0] = '0' + (uiVal >> 6);
+      acIdx[1] = '0' + ((uiVal >> 3) & 0x07);
+      acIdx[2] = '0' + (uiVal & 0x07);
+    }
+    else
+    {
+      acIdx[0] = ' ';
+      acIdx[1] = ' ';
+      acIdx[2] = ' ';
+    }
+
+    acIdx += 3;
+  }
+
+  return acIdx;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderData_dec8()                                                          */
+/*----------------------------------------------------------------------------*/
+static char_t* renderData_dec8(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx)
+{
+  (void) pOp;
+  (void) uiParam;
+
+  for (uint8_t i = 0; i < pRead->uiStride; ++i)
+  {
+    if (0 != i)
+    {
+      *acIdx++ = ' ';
+    }
+
+    if ((uiFrom <= i) && (i < uiTo))
+    {
+      uint8_t uiVal = pRead->uiData[i];
+
+      acIdx[0] = (100 <= uiVal ? '0' + (uiVal / 100) : ' ');
+      acIdx[1] = (10 <= uiVal ? '0' + ((uiVal / 10) % 10) : ' ');
+      acIdx[2] = '0' + (uiVal % 10);
+    }
+    else
+    {
+      acIdx[0] = ' ';
+      acIdx[1] = ' ';
+      acIdx[2] = ' ';
+    }
+
+    acIdx += 3;
+  }
+
+  return acIdx;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderData_dec16()                                                         */
+/*----------------------------------------------------------------------------*/
+static char_t* renderData_dec16(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx)
+{
+  /* Index of the most/least significant byte of a word */
+  uint8_t uiHigh = (pOp->bBigEndian ? 0 : 1);
+  uint8_t uiLow  = 1 - uiHigh;
+
+  (void) uiParam;
+
+  for (uint8_t i = 0; i < pRead->uiStride; i += 2)
+  {
+    if (0 != i)
+    {
+      *acIdx++ = ' ';
+    }
+
+    memset(acIdx, ' ', 5);
+
+    if ((uiFrom <= i) && ((i + 2) <= uiTo))
+    {
+      uint16_t uiVal   = ((uint16_t) pRead->uiData[i + uiHigh] << 8) | pRead->uiData[i + uiLow];
+      char_t*  acDigit = acIdx + 5;
+
+      do
       {
-        *acIdx++ = ' ';
-        *acIdx++ = ' ';
-      }
+        *--acDigit = '0' + (uint8_t) (uiVal % 10);
+        uiVal /= 10;
+      } while (0 != uiVal);
+    }
+
+    acIdx += 5;
+  }
+
+  return acIdx;
+}
+
 
+/*----------------------------------------------------------------------------*/
+/* renderData_dec32()                                                         */
+/*----------------------------------------------------------------------------*/
+static char_t* renderData_dec32(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx)
+{
+  (void) uiParam;
+
+  for (uint8_t i = 0; i < pRead->uiStride; i += 4)
+  {
+    if (0 != i)
+    {
       *acIdx++ = ' ';
     }
 
-    *acIdx++ = cSEPERATOR_CHAR;
-    *acIdx++ = ' ';
+    memset(acIdx, ' ', 10);
 
-    for (uint8_t i = 0; i < pRead->uiStride; ++i)
+    if ((uiFrom <= i) && ((i + 4) <= uiTo))
     {
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+      const uint8_t* pByte = &pRead->uiData[i];
+      char_t*        acDigit = acIdx + 10;
+      uint32_t       uiVal;
+
+      if (pOp->bBigEndian)
       {
-        *acIdx++ = (between_uint8(pRead->uiData[i], cFIRST_CHAR, cLAST_CHAR) ? pRead->uiData[i] : '.');
+        uiVal = ((uint32_t) pByte[0] << 24) | ((uint32_t) pByte[1] << 16) | ((uint16_t) pByte[2] << 8) | pByte[3];
       }
       else
       {
-        *acIdx++ = ' ';
+        uiVal = ((uint32_t) pByte[3] << 24) | ((uint32_t) pByte[2] << 16) | ((uint16_t) pByte[1] << 8) | pByte[0];
       }
+
+      do
+      {
+        *--acDigit = '0' + (uint8_t) (uiVal % 10);
+        uiVal /= 10;
+      } while (0 != uiVal);
     }
 
-    uiReturn = (uint16_t) (acIdx - acBegin);
+    acIdx += 10;
   }
 
-  return uiReturn;
+  return acIdx;
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* renderFrame_64()                                                           */
+/* renderData_word()                                                          */
 /*----------------------------------------------------------------------------*/
-static uint16_t renderFrame_64(
-  uint16_t uiIdx,
-  const readbuffer_t* pRead,
-  renderbuffer_t* pRender)
+static char_t* renderData_word(const dataop_t* pOp, uint8_t uiParam, const readbuffer_t* pRead, uint8_t uiFrom, uint8_t uiTo, char_t* acIdx)
 {
-  uint16_t uiReturn = 0;
+  /* The most significant byte is rendered first */
+  uint8_t uiFirst = (pOp->bBigEndian ? 0 : pOp->uiSize - 1);
+  int8_t  iStep   = (pOp->bBigEndian ? 1 : -1);
 
-  if ((0 != pRead) && (0 != pRender))
-  {
-    char_t* acBegin = &pRender->acData[uiIdx];
-    char_t* acIdx   = acBegin;
+  (void) uiParam;
 
-    *acIdx++ = cSEPERATOR_CHAR;
+  for (uint8_t i = 0; i < pRead->uiStride; i += pOp->uiSize)
+  {
+    if (0 != i)
+    {
+      *acIdx++ = ' ';
+    }
 
-    for (uint8_t i = 0; i < pRead->uiStride; i += 2)
+    if ((uiFrom <= i) && ((i + pOp->uiSize) <= uiTo))
     {
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+      const uint8_t* pByte = &pRead->uiData[i + uiFirst];
+
+      for (uint8_t j = 0; j < pOp->uiSize; ++j, pByte += iStep)
       {
-        byte2hex(pRead->uiData[i], acIdx);
+        byte2hex(*pByte, acIdx);
         acIdx += 2;
       }
+    }
+    else
+    {
+      memset(acIdx, ' ', pOp->uiWidth);
+      acIdx += pOp->uiWidth;
+    }
+  }
+
+  return acIdx;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderAddr_24()                                                            */
+/*----------------------------------------------------------------------------*/
+static uint8_t renderAddr_24(uint32_t uiAddr, char_t* acHex)
+{
+  const uint8_t* pByte = (const uint8_t*) &uiAddr;
+
+  byte2hex(pByte[2], &acHex[0]);
+  byte2hex(pByte[1], &acHex[2]);
+  byte2hex(pByte[0], &acHex[4]);
+
+  return 6;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderAddr_32()                                                            */
+/*----------------------------------------------------------------------------*/
+static uint8_t renderAddr_32(uint32_t uiAddr, char_t* acHex)
+{
+  long2hex(uiAddr, acHex);
+
+  return 8;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderCell()                                                               */
+/*----------------------------------------------------------------------------*/
+int renderCell(
+  const readbuffer_t* pRead,
+  const renderbuffer_t* pRender,
+  uint8_t uiIdx,
+  cellinfo_t* pCell)
+{
+  int iReturn = EINVAL;
+
+  if ((0 != pRead) && (0 != pRender) && (0 != pCell) && (uiIdx < pRead->uiStride))
+  {
+    if (between_uint32(pRead->uiAddr + uiIdx, pRead->uiLower, pRead->uiUpper, 1))
+    {
+      uint8_t uiVal = pRead->uiData[uiIdx];
+
+      if (uiNO_COLUMN != pRender->uiHexCol)
+      {
+        pCell->uiHexCol = pRender->uiHexCol
+                        + (uiIdx * 2)
+                        + (0 != pRender->uiHexGroup ? uiIdx / pRender->uiHexGroup : 0);
+      }
       else
       {
-        *acIdx++ = ' ';
-        *acIdx++ = ' ';
+        pCell->uiHexCol = uiNO_COLUMN;
       }
 
-      if (between_uint32(pRead->uiAddr + i + 1, pRead->uiLower, pRead->uiUpper, 1))
+      if (uiNO_COLUMN != pRender->uiCharCol)
+      {
+        pCell->uiCharCol = pRender->uiCharCol + uiIdx;
+      }
+      else
       {
-        byte2hex(pRead->uiData[i + 1], acIdx);
+        pCell->uiCharCol = uiNO_COLUMN;
       }
-      acIdx += 2;
 
-      *acIdx++ = ' ';
+      byte2hex(uiVal, pCell->acHex);
+      pCell->acHex[2]  = '\0';
+      pCell->acChar[0] = (between_uint8(uiVal, cFIRST_CHAR, cLAST_CHAR) ? uiVal : '.');
+      pCell->acChar[1] = '\0';
+
+      iReturn = EOK;
     }
+    else
+    {
+      iReturn = ERANGE;
+    }
+  }
+
+  return iReturn;
+}
+
 
-    *acIdx++ = cSEPERATOR_CHAR;
+/*----------------------------------------------------------------------------*/
+/* renderDecode()                                                             */
+/*----------------------------------------------------------------------------*/
+int renderDecode(
+  const uint8_t* pData,
+  uint8_t uiLen,
+  uint32_t uiAddr,
+  uint8_t uiRow,
+  char_t* acText)
+{
+  int iReturn = EINVAL;
+
+  if ((0 != acText) && (uiRow < uiDECODE_ROWS) && ((0 != pData) || (0 == uiLen)))
+  {
+    uint8_t uiItem = uiRow >> 1;
+    char_t  acValue[uiDECODE_COLS];
+    uint8_t uiCount;
 
-    for (uint8_t i = 0; i < pRead->uiStride; ++i)
+    acText[0] = cSEPERATOR_CHAR;
+    memset(&acText[1], ' ', uiDECODE_COLS - 1);
+    acText[uiDECODE_COLS] = '\0';
+
+    if (0 == (uiRow & 1))
+    {
+      uiCount = strlen(g_acDecodeLabel[uiItem]);
+      memcpy(&acText[2], g_acDecodeLabel[uiItem], uiCount);
+    }
+    else
     {
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+      if (g_uiDecodeSize[uiItem] > uiLen)
       {
-        *acIdx++ = (between_uint8(pRead->uiData[i], cFIRST_CHAR, cLAST_CHAR) ? pRead->uiData[i] : '.');
+        acValue[0] = '-';
+        uiCount = 1;
       }
       else
       {
-        *acIdx++ = ' ';
+        uint16_t uiWord = ((uint16_t) pData[1] << 8) | pData[0];
+        uint32_t uiLong = 0;
+
+        if (4 <= uiLen)
+        {
+          uiLong = ((uint32_t) pData[3] << 24) | ((uint32_t) pData[2] << 16) | uiWord;
+        }
+
+        switch (uiItem)
+        {
+          case 0: /* uint16 LE */
+            uiCount = renderDecimal(uiWord, acValue);
+            break;
+
+          case 1: /* uint16 BE */
+            uiCount = renderDecimal((uint16_t) ((uiWord << 8) | (uiWord >> 8)), acValue);
+            break;
+
+          case 2: /* uint32 LE */
+            uiCount = renderDecimal(uiLong, acValue);
+            break;
+
+          case 3: /* uint32 BE */
+            uiCount = renderDecimal(((uint32_t) pData[0] << 24) | ((uint32_t) pData[1] << 16) | ((uint16_t) pData[2] << 8) | pData[3], acValue);
+            break;
+
+          case 4: /* float (little endian) */
+            uiCount = renderFloat(uiLong, acValue);
+            break;
+
+          default: /* address of the cursor */
+            uiCount = g_uiAddrLen[uiAddr >= uiMAX_ADDR_24 ? 1 : 0];
+            g_pfnAddr[uiAddr >= uiMAX_ADDR_24 ? 1 : 0](uiAddr, acValue);
+            break;
+        }
       }
+
+      /* Values are right aligned */
+      memcpy(&acText[uiDECODE_COLS - uiCount], acValue, uiCount);
     }
 
-    uiReturn = (uint16_t) (acIdx - acBegin);
+    iReturn = EOK;
   }
 
-  return uiReturn;
+  return iReturn;
 }
 
 
 /*----------------------------------------------------------------------------*/
-/* renderFrame_32()                                                           */
+/* renderDecimal()                                                            */
 /*----------------------------------------------------------------------------*/
-static uint16_t renderFrame_32(
-  uint16_t uiIdx,
-  const readbuffer_t* pRead,
-  renderbuffer_t* pRender)
+static uint8_t renderDecimal(uint32_t uiValue, char_t* acText)
+{
+  char_t  acDigit[10];
+  uint8_t uiCount = 0;
+
+  do
+  {
+    acDigit[uiCount++] = '0' + (uint8_t) (uiValue % 10);
+    uiValue /= 10;
+  } while (0 != uiValue);
+
+  for (uint8_t i = 0; i < uiCount; ++i)
+  {
+    acText[i] = acDigit[uiCount - 1 - i];
+  }
+
+  return uiCount;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* renderFloat()                                                              */
+/*----------------------------------------------------------------------------*/
+static uint8_t renderFloat(uint32_t uiBits, char_t* acText)
 {
-  uint16_t uiReturn = 0;
+  uint32_t uiMant = uiBits & UINT32_C(0x007FFFFF);
+  int16_t  iExp   = (int16_t) ((uiBits >> 23) & 0xFF);
+  int16_t  iDec   = 0;
+  char_t*  acIdx  = acText;
 
-  if ((0 != pRead) && (0 != pRender))
+  if (0 != (uiBits & UINT32_C(0x80000000)))
   {
-    char_t* acBegin = &pRender->acData[uiIdx];
-    char_t* acIdx   = acBegin;
+    *acIdx++ = '-';
+  }
 
-    *acIdx++ = cSEPERATOR_CHAR;
+  if (0xFF == iExp)
+  {
+    memcpy(acIdx, (0 != uiMant ? "nan" : "inf"), 3);
+    acIdx += 3;
+  }
+  else if ((0 == iExp) && (0 == uiMant))
+  {
+    memcpy(acIdx, "0.0", 3);
+    acIdx += 3;
+  }
+  else
+  {
+    char_t  acDigit[7];
+    uint8_t uiDigits;
+
+    /* value = uiMant * 2^iExp (denormals have no hidden bit) */
+    if (0 != iExp)
+    {
+      uiMant |= UINT32_C(0x00800000);
+    }
+    else
+    {
+      iExp = 1;
+    }
 
-    for (uint8_t i = 0; i < pRead->uiStride; ++i)
+    iExp -= 150;
+
+    /* value = uiMant * 10^iDec: the binary exponent is moved into the
+       mantissa, which is kept as large as possible to save the precision */
+    while (0 < iExp)
     {
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+      if (uiMant < UINT32_C(0x80000000))
       {
-        byte2hex(pRead->uiData[i], acIdx);
-        acIdx += 2;
+        uiMant <<= 1;
+        --iExp;
       }
       else
       {
-        *acIdx++ = ' ';
-        *acIdx++ = ' ';
+        uiMant /= 10;
+        ++iDec;
       }
     }
 
-    *acIdx++ = cSEPERATOR_CHAR;
-
-    for (uint8_t i = 0; i < pRead->uiStride; ++i)
+    while (0 > iExp)
     {
-      if (between_uint32(pRead->uiAddr + i, pRead->uiLower, pRead->uiUpper, 1))
+      if (uiMant < UINT32_C(0x19999999))
       {
-        *acIdx++ = (between_uint8(pRead->uiData[i], cFIRST_CHAR, cLAST_CHAR) ? pRead->uiData[i] : '.');
+        uiMant *= 10;
+        --iDec;
       }
       else
       {
-        *acIdx++ = ' ';
+        uiMant >>= 1;
+        ++iExp;
       }
     }
 
-    uiReturn = (uint16_t) (acIdx - acBegin);
+    /* 8 digits: value = d.ddddddd * 10^(iDec + 7) */
+    while (uiMant < UINT32_C(10000000))
+    {
+      uiMant *= 10;
+      --iDec;
+    }
+
+    while (uiMant >= UINT32_C(100000000))
+    {
+      uiMant /= 10;
+      ++iDec;
+    }
+
+    iDec += 7;
+
+    /* Fixed point for 1.0 - 9999999, scientific notation otherwise */
+    uiDigits = (((0 <= iDec) && (6 >= iDec)) ? 7 : 4);
+    uiMant   = (uiMant + (7 == uiDigits ? 5 : 5000)) / (7 == uiDigits ? 10 : 10000);
+
+    if (uiMant >= (7 == uiDigits ? UINT32_C(10000000) : UINT32_C(10000)))
+    {
+      uiMant /= 10;
+      ++iDec;
+    }
+
+    if ((7 == uiDigits) && (6 < iDec))
+    {
+      uiMant /= 1000;
+      uiDigits = 4;
+    }
+
+    for (uint8_t i = uiDigits; 0 < i--; )
+    {
+      acDigit[i] = '0' + (uint8_t) (uiMant % 10);
+      uiMant /= 10;
+    }
+
+    if (7 == uiDigits)
+    {
+      uint8_t uiLast = uiDigits;
+
+      /* Trailing zeros of the fraction are omitted (one digit remains) */
+      while ((uiLast > iDec + 2) && ('0' == acDigit[uiLast - 1]))
+      {
+        --uiLast;
+      }
+
+      for (uint8_t i = 0; i < uiLast; ++i)
+      {
+        *acIdx++ = acDigit[i];
+
+        if ((i == iDec) && ((i + 1) < uiLast))
+        {
+          *acIdx++ = '.';
+        }
+      }
+    }
+    else
+    {
+      *acIdx++ = acDigit[0];
+      *acIdx++ = '.';
+      memcpy(acIdx, &acDigit[1], 3);
+      acIdx += 3;
+      *acIdx++ = 'e';
+      *acIdx++ = (0 > iDec ? '-' : '+');
+
+      iDec = (0 > iDec ? -iDec : iDec);
+      *acIdx++ = '0' + (uint8_t) (iDec / 10);
+      *acIdx++ = '0' + (uint8_t) (iDec % 10);
+    }
   }
 
-  return uiReturn;
+  return (uint8_t) (acIdx - acText);
 }
 
 
@@ -39,11 +39,13 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <errno.h>
+#include <string.h>
 #include <arch/zxn.h>
 #include <arch/zxn/esxdos.h>
 
 #include "libzxn.h"
 #include "bindump.h"
+#include "buffer.h"
 #include "save.h"
 
 /*============================================================================*/
@@ -61,6 +63,10 @@
 /*============================================================================*/
 /*                               Variablen                                    */
 /*============================================================================*/
+/*!
+Number of bytes in the write buffer
+*/
+static uint16_t g_uiWriteLen = 0;
 
 /*============================================================================*/
 /*                               Strukturen                                   */
@@ -89,6 +95,16 @@ This function saves a raw data block to a file.
 */
 static int saveFrame_raw(const readbuffer_t* pRead, const fileinfo_t* pFile);
 
+/*!
+This function appends data to the write buffer; a full buffer is written to
+the file. Without write buffer the data is written directly.
+@param pData Pointer to the data
+@param uiLen Length of the data
+@param pFile Pointer to the file info
+@return EOK = no error
+*/
+static int writeData(const uint8_t* pData, uint16_t uiLen, const fileinfo_t* pFile);
+
 /*============================================================================*/
 /*                               Klassen                                      */
 /*============================================================================*/
@@ -133,18 +149,12 @@ static int saveFrame_hex(const renderbuffer_t* pRender, const fileinfo_t* pFile)
     {
       if (EOK == iReturn)
       {
-        if (pRender->uiLen != esx_f_write(pFile->hFile, pRender->acData, pRender->uiLen))
-        {
-          iReturn = EBADF;
-        }
+        iReturn = writeData(pRender->acData, pRender->uiLen, pFile);
       }
 
       if (EOK == iReturn)
       {
-        if (1 != esx_f_write(pFile->hFile, "\n", 1))
-        {
-          iReturn = EBADF;
-        }
+        iReturn = writeData("\n", 1, pFile);
       }
     }
   }
@@ -174,15 +184,69 @@ static int saveFrame_raw(const readbuffer_t* pRead, const fileinfo_t* pFile)
 
       uiFrom = (pRead->uiAddr < pRead->uiLower ? pRead->uiLower - pRead->uiAddr  : 0);
       uiTo   = ((pRead->uiAddr + pRead->uiStride) >= pRead->uiUpper ?
-                (pRead->uiAddr + pRead->uiStride) - pRead->uiUpper :
+                pRead->uiUpper - pRead->uiAddr :
                 pRead->uiStride);
       uiLen  = uiTo - uiFrom;
 
-      if (uiLen != esx_f_write(pFile->hFile, &pRead->uiData[uiFrom], uiLen))
+      iReturn = writeData(&pRead->uiData[uiFrom], uiLen, pFile);
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* saveBlock()                                                                */
+/*----------------------------------------------------------------------------*/
+int saveBlock(const uint8_t* pData, uint16_t uiLen, const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if ((0 != pData) && (0 != pFile))
+  {
+    if (INV_FILE_HND != pFile->hFile)
+    {
+      iReturn = writeData(pData, uiLen, pFile);
+    }
+    else
+    {
+      iReturn = EBADF;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* saveFlush()                                                                */
+/*----------------------------------------------------------------------------*/
+int saveFlush(const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if (0 != pFile)
+  {
+    if ((0 < g_uiWriteLen) && (INV_FILE_HND != pFile->hFile))
+    {
+      if (g_uiWriteLen != esx_f_write(pFile->hFile, bufferMap(BUFFER_WRITE), g_uiWriteLen))
       {
         iReturn = EBADF;
       }
+
+      bufferUnmap();
     }
+
+    g_uiWriteLen = 0;
   }
   else
   {
@@ -193,6 +257,47 @@ static int saveFrame_raw(const readbuffer_t* pRead, const fileinfo_t* pFile)
 }
 
 
+/*----------------------------------------------------------------------------*/
+/* writeData()                                                                */
+/*----------------------------------------------------------------------------*/
+static int writeData(const uint8_t* pData, uint16_t uiLen, const fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if (bufferAvailable(BUFFER_WRITE))
+  {
+    while ((EOK == iReturn) && (0 < uiLen))
+    {
+      uint16_t uiPart = uiBUFFER_SIZE - g_uiWriteLen;
+
+      if (uiPart > uiLen)
+      {
+        uiPart = uiLen;
+      }
+
+      /* Copied by the CPU: the zxnDMA may still prefetch the next block */
+      zxn_ldi(bufferMap(BUFFER_WRITE) + g_uiWriteLen, pData, uiPart);
+      bufferUnmap();
+
+      g_uiWriteLen += uiPart;
+      pData        += uiPart;
+      uiLen        -= uiPart;
+
+      if (uiBUFFER_SIZE == g_uiWriteLen)
+      {
+        iReturn = saveFlush(pFile);
+      }
+    }
+  }
+  else if (uiLen != esx_f_write(pFile->hFile, pData, uiLen))
+  {
+    iReturn = EBADF;
+  }
+
+  return iReturn;
+}
+
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,435 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: snapshot.c                                                         |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bindump.h"
+#include "snapshot.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Position of a bank, that is stored compressed (Z80)
+*/
+#define uiSNAP_PACKED (UINT32_C(0xFFFFFFFE))
+
+/*!
+Sizes of the SNA formats (48K, 128K, 128K with bank 2/5 paged in twice)
+*/
+#define uiSNA_SIZE_48K     (UINT32_C(49179))
+#define uiSNA_SIZE_128K    (UINT32_C(131103))
+#define uiSNA_SIZE_128K_EX (UINT32_C(147487))
+
+/*!
+Size of the SNA header
+*/
+#define uiSNA_HEADER (27)
+
+/*!
+Size of the NEX header
+*/
+#define uiNEX_HEADER (512)
+
+/*!
+Size of the Z80 header (version 1)
+*/
+#define uiZ80_HEADER (30)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Format of the indexed snapshot
+*/
+static snaptype_t g_eType = SNAP_NONE;
+
+/*!
+File positions of all banks (uiPOS_UNKNOWN = not part of the snapshot)
+*/
+static uint32_t g_uiBank[uiSNAP_BANKS];
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Read data from a given position of a file
+@param pFile Pointer to the file info
+@param uiPos Position in the file
+@param pData Pointer to the destination buffer
+@param uiLen Number of bytes to read
+@return EOK = no error
+*/
+static int readAt(fileinfo_t* pFile, uint32_t uiPos, void* pData, uint16_t uiLen);
+
+/*!
+Build the index of a NEX file
+@param pFile Pointer to the file info
+@return EOK = no error
+*/
+static int indexNex(fileinfo_t* pFile);
+
+/*!
+Build the index of a SNA file (48K/128K)
+@param pFile Pointer to the file info
+@param uiSize Size of the file
+@return EOK = no error
+*/
+static int indexSna(fileinfo_t* pFile, uint32_t uiSize);
+
+/*!
+Build the index of a Z80 file (version 1-3)
+@param pFile Pointer to the file info
+@return EOK = no error
+*/
+static int indexZ80(fileinfo_t* pFile);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* snapshotIndex()                                                            */
+/*----------------------------------------------------------------------------*/
+int snapshotIndex(fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if (0 != pFile)
+  {
+    if (INV_FILE_HND != pFile->hFile)
+    {
+      struct esx_stat tStat;
+      char_t acMagic[4];
+
+      g_eType = SNAP_NONE;
+
+      for (uint8_t i = 0; i < uiSNAP_BANKS; ++i)
+      {
+        g_uiBank[i] = uiPOS_UNKNOWN;
+      }
+
+      if (0 != esx_f_fstat(pFile->hFile, &tStat))
+      {
+        iReturn = EBADF;
+      }
+      else if (EOK == (iReturn = readAt(pFile, 0, acMagic, sizeof(acMagic))))
+      {
+        if (0 == memcmp(acMagic, "Next", sizeof(acMagic)))
+        {
+          iReturn = indexNex(pFile);
+        }
+        else if (hasExtension(pFile->acPathName, ".sna"))
+        {
+          iReturn = indexSna(pFile, tStat.size);
+        }
+        else if (hasExtension(pFile->acPathName, ".z80"))
+        {
+          iReturn = indexZ80(pFile);
+        }
+        else
+        {
+          iReturn = ENOTSUP; /* Error: no snapshot */
+        }
+      }
+
+      /* Position of the file has been changed */
+      pFile->uiPos = uiPOS_UNKNOWN;
+    }
+    else
+    {
+      iReturn = ESTAT;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* snapshotBank()                                                             */
+/*----------------------------------------------------------------------------*/
+int snapshotBank(uint8_t uiBank, uint32_t* pOffset)
+{
+  int iReturn = EOK;
+
+  if (0 != pOffset)
+  {
+    if ((SNAP_NONE == g_eType) || (uiSNAP_BANKS <= uiBank) || (uiPOS_UNKNOWN == g_uiBank[uiBank]))
+    {
+      iReturn = ERANGE;
+    }
+    else if (uiSNAP_PACKED == g_uiBank[uiBank])
+    {
+      iReturn = ENOTSUP;
+    }
+    else
+    {
+      *pOffset = g_uiBank[uiBank];
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readAt()                                                                   */
+/*----------------------------------------------------------------------------*/
+static int readAt(fileinfo_t* pFile, uint32_t uiPos, void* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  if (UINT32_C(-1) == esx_f_seek(pFile->hFile, uiPos, ESX_SEEK_SET))
+  {
+    iReturn = EBADF;
+  }
+  else if (uiLen != esx_f_read(pFile->hFile, pData, uiLen))
+  {
+    iReturn = EBADF;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* indexNex()                                                                 */
+/*----------------------------------------------------------------------------*/
+static int indexNex(fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  uint8_t uiFlags;
+  uint8_t uiPresent[uiSNAP_BANKS];
+
+  /* Loading screen flags (10) and banks included in the file (18-129) */
+  if (EOK == (iReturn = readAt(pFile, 10, &uiFlags, sizeof(uiFlags))))
+  {
+    iReturn = readAt(pFile, 18, uiPresent, sizeof(uiPresent));
+  }
+
+  if (EOK == iReturn)
+  {
+    /* Banks 5, 2, 0 first; then all other banks in ascending order */
+    static const uint8_t uiOrder[] = {5, 2, 0, 1, 3, 4, 6, 7};
+
+    uint32_t uiPos = uiNEX_HEADER;
+
+    /* Palette (Layer 2, LoRes, Layer 2 320/640) and loading screens */
+    if ((0 == (uiFlags & 0x80)) && (0 != (uiFlags & 0x45)))
+    {
+      uiPos += 512;
+    }
+
+    uiPos += (0 != (uiFlags & 0x01) ? UINT32_C(49152) : 0); /* Layer 2         */
+    uiPos += (0 != (uiFlags & 0x02) ? UINT32_C(6912)  : 0); /* ULA             */
+    uiPos += (0 != (uiFlags & 0x04) ? UINT32_C(12288) : 0); /* LoRes           */
+    uiPos += (0 != (uiFlags & 0x08) ? UINT32_C(12288) : 0); /* Timex HiRes     */
+    uiPos += (0 != (uiFlags & 0x10) ? UINT32_C(12288) : 0); /* Timex HiColour  */
+    uiPos += (0 != (uiFlags & 0x40) ? UINT32_C(81920) : 0); /* Layer 2 320/640 */
+
+    for (uint8_t i = 0; i < uiSNAP_BANKS; ++i)
+    {
+      uint8_t uiBank = (i < sizeof(uiOrder) ? uiOrder[i] : i);
+
+      if (0 != uiPresent[uiBank])
+      {
+        g_uiBank[uiBank] = uiPos;
+        uiPos += uiSNAP_BANK_SIZE;
+      }
+    }
+
+    g_eType = SNAP_NEX;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* indexSna()                                                                 */
+/*----------------------------------------------------------------------------*/
+static int indexSna(fileinfo_t* pFile, uint32_t uiSize)
+{
+  int iReturn = EOK;
+
+  if ((uiSNA_SIZE_48K == uiSize) || (uiSNA_SIZE_128K == uiSize) || (uiSNA_SIZE_128K_EX == uiSize))
+  {
+    uint8_t uiPaged = 0; /* Bank paged in at 0xC000 */
+
+    if (uiSNA_SIZE_48K != uiSize)
+    {
+      /* Header (27), 48K, PC (2), port 0x7FFD (1), TR-DOS (1), other banks */
+      if (EOK == (iReturn = readAt(pFile, uiSNA_SIZE_48K + 2, &uiPaged, sizeof(uiPaged))))
+      {
+        uint32_t uiPos = uiSNA_SIZE_48K + 4;
+
+        uiPaged &= 0x07;
+
+        for (uint8_t i = 0; i < 8; ++i)
+        {
+          if ((5 != i) && (2 != i) && (uiPaged != i))
+          {
+            g_uiBank[i] = uiPos;
+            uiPos += uiSNAP_BANK_SIZE;
+          }
+        }
+      }
+    }
+
+    if (EOK == iReturn)
+    {
+      g_uiBank[5]       = uiSNA_HEADER;
+      g_uiBank[2]       = uiSNA_HEADER + uiSNAP_BANK_SIZE;
+      g_uiBank[uiPaged] = uiSNA_HEADER + (2 * uiSNAP_BANK_SIZE);
+
+      g_eType = SNAP_SNA;
+    }
+  }
+  else
+  {
+    iReturn = ENOTSUP;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* indexZ80()                                                                 */
+/*----------------------------------------------------------------------------*/
+static int indexZ80(fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  uint8_t uiHeader[uiZ80_HEADER + 5];
+
+  if (EOK == (iReturn = readAt(pFile, 0, uiHeader, sizeof(uiHeader))))
+  {
+    if ((0 != uiHeader[6]) || (0 != uiHeader[7])) /* Version 1: 48K only */
+    {
+      bool bPacked = ((0xFF != uiHeader[12]) && (0 != (uiHeader[12] & 0x20)));
+
+      for (uint8_t i = 0; i < 3; ++i)
+      {
+        static const uint8_t uiOrder[] = {5, 2, 0};
+
+        g_uiBank[uiOrder[i]] = (bPacked ? uiSNAP_PACKED : uiZ80_HEADER + (i * uiSNAP_BANK_SIZE));
+      }
+    }
+    else /* Version 2/3: list of memory blocks */
+    {
+      uint16_t uiExtra = ((uint16_t) uiHeader[31] << 8) | uiHeader[30];
+      uint8_t  uiHw    = uiHeader[34];
+      bool     b48K    = ((uiHw < 2) || ((23 != uiExtra) && (3 == uiHw)));
+      uint32_t uiPos   = uiZ80_HEADER + 2 + uiExtra;
+      uint8_t  uiBlock[3];
+
+      /* Block: length (0xFFFF = not compressed), page number, data */
+      while (EOK == readAt(pFile, uiPos, uiBlock, sizeof(uiBlock)))
+      {
+        uint16_t uiLen  = ((uint16_t) uiBlock[1] << 8) | uiBlock[0];
+        uint8_t  uiPage = uiBlock[2];
+        uint8_t  uiBank = 0xFF;
+
+        uiPos += sizeof(uiBlock);
+
+        if (b48K)
+        {
+          uiBank = (8 == uiPage ? 5 : (4 == uiPage ? 2 : (5 == uiPage ? 0 : 0xFF)));
+        }
+        else if ((3 <= uiPage) && (10 >= uiPage))
+        {
+          uiBank = uiPage - 3;
+        }
+
+        if (0xFF != uiBank)
+        {
+          g_uiBank[uiBank] = (0xFFFF == uiLen ? uiPos : uiSNAP_PACKED);
+        }
+
+        uiPos += (0xFFFF == uiLen ? uiSNAP_BANK_SIZE : uiLen);
+      }
+    }
+
+    g_eType = SNAP_Z80;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
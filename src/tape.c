@@ -0,0 +1,446 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: tape.c                                                             |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bindump.h"
+#include "tape.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Signature at the beginning of a TZX file
+*/
+#define acTZX_MAGIC "ZXTape!\x1A"
+
+/*!
+Size of the TZX header (signature, major and minor version)
+*/
+#define uiTZX_HEADER (10)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Format of the indexed tape image
+*/
+static tapetype_t g_eType = TAPE_NONE;
+
+/*!
+Number of blocks in the index
+*/
+static uint8_t g_uiCount = 0;
+
+/*!
+Size of the tape image (end of the last block)
+*/
+static uint32_t g_uiEnd = 0;
+
+/*!
+Positions of all blocks in the file
+*/
+static uint32_t g_uiOffset[uiTAPE_BLOCKS];
+
+/*!
+Types of all blocks (TAP: flag byte; TZX: ID)
+*/
+static uint8_t g_uiType[uiTAPE_BLOCKS];
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+Description of the length of a TZX block (without ID):
+uiFixed + uiScale * (length field of uiBytes bytes at position uiPos)
+*/
+typedef struct _tzxblock
+{
+  uint8_t uiId;
+  uint8_t uiFixed;
+  uint8_t uiPos;
+  uint8_t uiBytes;
+  uint8_t uiScale;
+} tzxblock_t;
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Walk through the blocks of a TAP file
+@param pFile Pointer to the file info
+@param uiSize Size of the file
+@return EOK = no error
+*/
+static int indexTap(fileinfo_t* pFile, uint32_t uiSize);
+
+/*!
+Walk through the blocks of a TZX file
+@param pFile Pointer to the file info
+@param uiSize Size of the file
+@return EOK = no error
+*/
+static int indexTzx(fileinfo_t* pFile, uint32_t uiSize);
+
+/*!
+Read a little endian value of 1-4 bytes
+@param pData Pointer to the value
+@param uiBytes Size of the value
+@return Value
+*/
+static uint32_t readLE(const uint8_t* pData, uint8_t uiBytes);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*!
+Lengths of the TZX blocks; all other blocks start with a 32 bit length
+*/
+static const tzxblock_t g_tTzxBlocks[] =
+{
+  {0x10, 0x04, 0x02, 2, 1}, /* Standard speed data   */
+  {0x11, 0x12, 0x0F, 3, 1}, /* Turbo speed data      */
+  {0x12, 0x04, 0x00, 0, 0}, /* Pure tone             */
+  {0x13, 0x01, 0x00, 1, 2}, /* Pulse sequence        */
+  {0x14, 0x0A, 0x07, 3, 1}, /* Pure data             */
+  {0x15, 0x08, 0x05, 3, 1}, /* Direct recording      */
+  {0x20, 0x02, 0x00, 0, 0}, /* Pause                 */
+  {0x21, 0x01, 0x00, 1, 1}, /* Group start           */
+  {0x22, 0x00, 0x00, 0, 0}, /* Group end             */
+  {0x23, 0x02, 0x00, 0, 0}, /* Jump to block         */
+  {0x24, 0x02, 0x00, 0, 0}, /* Loop start            */
+  {0x25, 0x00, 0x00, 0, 0}, /* Loop end              */
+  {0x26, 0x02, 0x00, 2, 2}, /* Call sequence         */
+  {0x27, 0x00, 0x00, 0, 0}, /* Return from sequence  */
+  {0x28, 0x02, 0x00, 2, 1}, /* Select block          */
+  {0x30, 0x01, 0x00, 1, 1}, /* Text description      */
+  {0x31, 0x02, 0x01, 1, 1}, /* Message               */
+  {0x32, 0x02, 0x00, 2, 1}, /* Archive info          */
+  {0x33, 0x01, 0x00, 1, 3}, /* Hardware type         */
+  {0x35, 0x14, 0x10, 4, 1}, /* Custom info           */
+  {0x5A, 0x09, 0x00, 0, 0}, /* Glue                  */
+};
+
+
+/*----------------------------------------------------------------------------*/
+/* tapeIndex()                                                                */
+/*----------------------------------------------------------------------------*/
+int tapeIndex(fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if (0 != pFile)
+  {
+    if (INV_FILE_HND != pFile->hFile)
+    {
+      struct esx_stat tStat;
+      char_t acMagic[sizeof(acTZX_MAGIC) - 1];
+
+      g_eType   = TAPE_NONE;
+      g_uiCount = 0;
+      g_uiEnd   = 0;
+
+      if ((0 != esx_f_fstat(pFile->hFile, &tStat)) ||
+          (UINT32_C(-1) == esx_f_seek(pFile->hFile, 0, ESX_SEEK_SET)))
+      {
+        iReturn = EBADF;
+      }
+      else if ((sizeof(acMagic) == esx_f_read(pFile->hFile, acMagic, sizeof(acMagic))) &&
+               (0 == memcmp(acMagic, acTZX_MAGIC, sizeof(acMagic))))
+      {
+        iReturn = indexTzx(pFile, tStat.size);
+      }
+      else if (hasExtension(pFile->acPathName, ".tap"))
+      {
+        iReturn = indexTap(pFile, tStat.size);
+      }
+      else
+      {
+        iReturn = ENOTSUP; /* Error: no tape image */
+      }
+
+      /* Position of the file has been changed */
+      pFile->uiPos = uiPOS_UNKNOWN;
+    }
+    else
+    {
+      iReturn = ESTAT;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* tapeCount()                                                                */
+/*----------------------------------------------------------------------------*/
+uint8_t tapeCount(void)
+{
+  return g_uiCount;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* tapeBlock()                                                                */
+/*----------------------------------------------------------------------------*/
+int tapeBlock(uint8_t uiIndex, uint32_t* pOffset, uint32_t* pSize, uint8_t* pType)
+{
+  int iReturn = EOK;
+
+  if ((0 != pOffset) && (0 != pSize))
+  {
+    if (uiIndex < g_uiCount)
+    {
+      uint32_t uiNext = (uiIndex + 1 < g_uiCount ? g_uiOffset[uiIndex + 1] : g_uiEnd);
+
+      *pOffset = g_uiOffset[uiIndex];
+      *pSize   = uiNext - g_uiOffset[uiIndex];
+
+      if (0 != pType)
+      {
+        *pType = g_uiType[uiIndex];
+      }
+    }
+    else
+    {
+      iReturn = ERANGE;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* tapeFind()                                                                 */
+/*----------------------------------------------------------------------------*/
+uint8_t tapeFind(uint32_t uiOffset)
+{
+  uint8_t uiReturn = uiTAPE_NONE;
+
+  if ((0 < g_uiCount) && (uiOffset >= g_uiOffset[0]) && (uiOffset < g_uiEnd))
+  {
+    uint8_t uiLow  = 0;
+    uint8_t uiHigh = g_uiCount - 1;
+
+    /* Binary search: last block starting at or before the offset */
+    while (uiLow < uiHigh)
+    {
+      uint8_t uiMid = (uint8_t) ((uiLow + uiHigh + 1) >> 1);
+
+      if (g_uiOffset[uiMid] <= uiOffset)
+      {
+        uiLow = uiMid;
+      }
+      else
+      {
+        uiHigh = uiMid - 1;
+      }
+    }
+
+    uiReturn = uiLow;
+  }
+
+  return uiReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* indexTap()                                                                 */
+/*----------------------------------------------------------------------------*/
+static int indexTap(fileinfo_t* pFile, uint32_t uiSize)
+{
+  int iReturn = EOK;
+
+  uint32_t uiPos = 0;
+  uint8_t  uiHeader[3]; /* Length and flag byte */
+
+  /* Block: length (2), flag (1), data, checksum (1) */
+  while ((uiPos + sizeof(uiHeader)) <= uiSize)
+  {
+    if ((UINT32_C(-1) == esx_f_seek(pFile->hFile, uiPos, ESX_SEEK_SET)) ||
+        (sizeof(uiHeader) != esx_f_read(pFile->hFile, uiHeader, sizeof(uiHeader))))
+    {
+      iReturn = EBADF;
+      break;
+    }
+
+    if (uiTAPE_BLOCKS <= g_uiCount)
+    {
+      break; /* Index full: the rest of the file belongs to the last block */
+    }
+
+    g_uiOffset[g_uiCount] = uiPos;
+    g_uiType[g_uiCount]   = uiHeader[2];
+    ++g_uiCount;
+
+    uiPos += 2 + readLE(uiHeader, 2);
+  }
+
+  if (EOK == iReturn)
+  {
+    g_uiEnd = uiSize;
+    g_eType = TAPE_TAP;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* indexTzx()                                                                 */
+/*----------------------------------------------------------------------------*/
+static int indexTzx(fileinfo_t* pFile, uint32_t uiSize)
+{
+  int iReturn = EOK;
+
+  uint32_t uiPos = uiTZX_HEADER;
+  uint8_t  uiHeader[0x15]; /* ID and the longest fixed part (custom info) */
+
+  while (uiPos < uiSize)
+  {
+    const tzxblock_t* pBlock = 0;
+    uint32_t uiLen;
+
+    memset(uiHeader, 0, sizeof(uiHeader));
+
+    /* A short read at the end of the file leaves zeros in the header */
+    if ((UINT32_C(-1) == esx_f_seek(pFile->hFile, uiPos, ESX_SEEK_SET)) ||
+        (0 == esx_f_read(pFile->hFile, uiHeader, sizeof(uiHeader))))
+    {
+      iReturn = EBADF;
+      break;
+    }
+
+    if (uiTAPE_BLOCKS <= g_uiCount)
+    {
+      break; /* Index full: the rest of the file belongs to the last block */
+    }
+
+    for (uint8_t i = 0; i < (sizeof(g_tTzxBlocks) / sizeof(g_tTzxBlocks[0])); ++i)
+    {
+      if (uiHeader[0] == g_tTzxBlocks[i].uiId)
+      {
+        pBlock = &g_tTzxBlocks[i];
+        break;
+      }
+    }
+
+    if (0 != pBlock)
+    {
+      uiLen = pBlock->uiFixed;
+
+      if (0 != pBlock->uiBytes)
+      {
+        uiLen += pBlock->uiScale * readLE(&uiHeader[1 + pBlock->uiPos], pBlock->uiBytes);
+      }
+    }
+    else
+    {
+      uiLen = 4 + readLE(&uiHeader[1], 4);
+    }
+
+    g_uiOffset[g_uiCount] = uiPos;
+    g_uiType[g_uiCount]   = uiHeader[0];
+    ++g_uiCount;
+
+    uiPos += 1 + uiLen;
+  }
+
+  if (EOK == iReturn)
+  {
+    g_uiEnd = uiSize;
+    g_eType = TAPE_TZX;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* readLE()                                                                   */
+/*----------------------------------------------------------------------------*/
+static uint32_t readLE(const uint8_t* pData, uint8_t uiBytes)
+{
+  uint32_t uiReturn = 0;
+
+  while (0 < uiBytes--)
+  {
+    uiReturn = (uiReturn << 8) | pData[uiBytes];
+  }
+
+  return uiReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
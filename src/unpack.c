@@ -0,0 +1,581 @@
+/*-----------------------------------------------------------------------------+
+|                                                                              |
+| filename: unpack.c                                                           |
+| project:  ZX Spectrum Next - BINDUMP                                         |
+| author:   Stefan Zell                                                        |
+| date:     10/18/2026                                                         |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| description:                                                                 |
+|                                                                              |
+| Application to dump binary content of memory and files                       |
+|                                                                              |
++------------------------------------------------------------------------------+
+|                                                                              |
+| Copyright (c) 10/18/2026 STZ Engineering                                     |
+|                                                                              |
+| This software is provided  "as is",  without warranty of any kind, express   |
+| or implied. In no event shall STZ or its contributors be held liable for any |
+| direct, indirect, incidental, special or consequential damages arising out   |
+| of the use of or inability to use this software.                             |
+|                                                                              |
+| Permission is granted to anyone  to use this  software for any purpose,      |
+| including commercial applications,  and to alter it and redistribute it      |
+| freely, subject to the following restrictions:                               |
+|                                                                              |
+| 1. Redistributions of source code must retain the above copyright            |
+|    notice, definition, disclaimer, and this list of conditions.              |
+|                                                                              |
+| 2. Redistributions in binary form must reproduce the above copyright         |
+|    notice, definition, disclaimer, and this list of conditions in            |
+|    documentation and/or other materials provided with the distribution.      |
+|                                                                          ;-) |
++-----------------------------------------------------------------------------*/
+
+
+/*============================================================================*/
+/*                               Includes                                     */
+/*============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <arch/zxn.h>
+#include <arch/zxn/esxdos.h>
+
+#include "libzxn.h"
+#include "bindump.h"
+#include "buffer.h"
+#include "unpack.h"
+
+/*============================================================================*/
+/*                               Defines                                      */
+/*============================================================================*/
+/*!
+Size of the window of the decoder (LZSS: 4K ring buffer)
+*/
+#define uiLZ_WINDOW (0x1000)
+
+/*!
+Max. length of a match
+*/
+#define uiLZ_MAXLEN (18)
+
+/*!
+Matches are at least uiLZ_THRESHOLD + 1 bytes long
+*/
+#define uiLZ_THRESHOLD (2)
+
+/*!
+Size of the input buffer
+*/
+#define uiLZ_INBUF (128)
+
+/*!
+Number of 8K banks for checkpoints (two windows per bank)
+*/
+#define uiLZ_PAGES (4)
+
+/*!
+Max. number of checkpoints
+*/
+#define uiLZ_CHECKS (2 * uiLZ_PAGES)
+
+/*!
+Initial distance of the checkpoints in the decoded data (power of 2); the
+distance is doubled, if all checkpoints are used
+*/
+#define uiLZ_GAP (UINT32_C(0x4000))
+
+/*!
+Size of the buffer to move a window between banks
+*/
+#define uiLZ_SWAP (0x100)
+
+/*============================================================================*/
+/*                               Namespaces                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Konstanten                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Strukturen                                   */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Typ-Definitionen                             */
+/*============================================================================*/
+/*!
+State of the decoder
+*/
+typedef struct _lzstate
+{
+  /*!
+  Position of the next input byte in the file
+  */
+  uint32_t uiIn;
+
+  /*!
+  Number of decoded bytes (position of the next output byte)
+  */
+  uint32_t uiOut;
+
+  /*!
+  Flags of the current group of 8 tokens (bit 8-15: marker)
+  */
+  uint16_t uiFlags;
+
+  /*!
+  Position of the next output byte in the window
+  */
+  uint16_t uiRing;
+
+  /*!
+  Position of the next byte of the current match in the window
+  */
+  uint16_t uiMatch;
+
+  /*!
+  Remaining bytes of the current match
+  */
+  uint8_t uiCount;
+} lzstate_t;
+
+/*============================================================================*/
+/*                               Variablen                                    */
+/*============================================================================*/
+/*!
+Current state of the decoder
+*/
+static lzstate_t g_tState;
+
+/*!
+Window of the decoder
+*/
+static uint8_t g_uiWindow[uiLZ_WINDOW];
+
+/*!
+Input buffer and position of it's first byte in the file
+*/
+static uint8_t  g_uiInBuf[uiLZ_INBUF];
+static uint32_t g_uiInPos = 0;
+static uint8_t  g_uiInLen = 0;
+
+/*!
+Size of the decoded data; 0 = file is not compressed
+*/
+static uint32_t g_uiSize = 0;
+
+/*!
+Checkpoints at the positions (i + 1) * g_uiGap of the decoded data
+*/
+static lzstate_t g_tCheck[uiLZ_CHECKS];
+static uint8_t   g_uiChecks = 0;
+static uint32_t  g_uiGap    = uiLZ_GAP;
+
+/*!
+Banks of NextOS with the windows of the checkpoints (0xFF = not allocated)
+*/
+static uint8_t g_uiPage[uiLZ_PAGES] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+/*============================================================================*/
+/*                               Prototypen                                   */
+/*============================================================================*/
+/*!
+Reset the decoder to the beginning of the file
+*/
+static void resetState(void);
+
+/*!
+Read the next input byte
+@param pFile Pointer to the file info
+@param pByte [OUT] Input byte
+@return true = byte read; false = end of file
+*/
+static bool nextInput(fileinfo_t* pFile, uint8_t* pByte);
+
+/*!
+Decode the next byte into the window
+@param pFile Pointer to the file info
+@return true = byte decoded; false = end of data
+*/
+static bool decodeByte(fileinfo_t* pFile);
+
+/*!
+Save the state of the decoder as checkpoint
+*/
+static void saveCheck(void);
+
+/*!
+Restore the nearest checkpoint below a position of the decoded data
+@param uiAddr Position in the decoded data
+*/
+static void restoreCheck(uint32_t uiAddr);
+
+/*!
+Copy a window between the decoder and a bank
+@param uiCheck Number of the checkpoint
+@param bSave true = window to bank; false = bank to window
+*/
+static void copyWindow(uint8_t uiCheck, bool bSave);
+
+/*!
+Move the window of a checkpoint to another checkpoint
+@param uiFrom Number of the source checkpoint
+@param uiTo Number of the destination checkpoint
+*/
+static void moveWindow(uint8_t uiFrom, uint8_t uiTo);
+
+/*============================================================================*/
+/*                               Klassen                                      */
+/*============================================================================*/
+
+/*============================================================================*/
+/*                               Implementierung                              */
+/*============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/* unpackOpen()                                                               */
+/*----------------------------------------------------------------------------*/
+int unpackOpen(fileinfo_t* pFile)
+{
+  int iReturn = EOK;
+
+  if (0 != pFile)
+  {
+    if (INV_FILE_HND != pFile->hFile)
+    {
+      g_uiSize = 0;
+
+      if (hasExtension(pFile->acPathName, acUNPACK_EXT))
+      {
+        /* Checkpoints are optional; they are not used, if no bank is left */
+        for (uint8_t i = 0; i < uiLZ_PAGES; ++i)
+        {
+          if (0xFF == g_uiPage[i])
+          {
+            g_uiPage[i] = bufferAlloc();
+          }
+        }
+
+        g_uiChecks = 0;
+        g_uiGap    = uiLZ_GAP;
+
+        resetState();
+
+        /* Decode the whole file once: size and checkpoints */
+        while (decodeByte(pFile))
+        {
+          if (0 == (g_tState.uiOut & (g_uiGap - 1)))
+          {
+            saveCheck();
+          }
+        }
+
+        g_uiSize = g_tState.uiOut;
+      }
+      else
+      {
+        iReturn = ENOTSUP; /* Error: not compressed */
+      }
+
+      /* Position of the file has been changed */
+      pFile->uiPos = uiPOS_UNKNOWN;
+    }
+    else
+    {
+      iReturn = ESTAT;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* unpackRead()                                                               */
+/*----------------------------------------------------------------------------*/
+int unpackRead(fileinfo_t* pFile, uint32_t uiAddr, uint8_t* pData, uint16_t uiLen)
+{
+  int iReturn = EOK;
+
+  if ((0 != pFile) && (0 != pData))
+  {
+    if ((uiAddr + uiLen) <= g_uiSize)
+    {
+      while (0 < uiLen)
+      {
+        if ((uiAddr < g_tState.uiOut) && ((g_tState.uiOut - uiAddr) <= uiLZ_WINDOW))
+        {
+          /* Byte is part of the window */
+          uint16_t uiPos = (uint16_t) (uiLZ_WINDOW - uiLZ_MAXLEN + uiAddr) & (uiLZ_WINDOW - 1);
+
+          *pData++ = g_uiWindow[uiPos];
+          ++uiAddr;
+          --uiLen;
+        }
+        else if (uiAddr < g_tState.uiOut)
+        {
+          restoreCheck(uiAddr);
+        }
+        else if (!decodeByte(pFile))
+        {
+          iReturn = EBADF;
+          break;
+        }
+      }
+
+      pFile->uiPos = uiPOS_UNKNOWN;
+    }
+    else
+    {
+      iReturn = ERANGE;
+    }
+  }
+  else
+  {
+    iReturn = EINVAL;
+  }
+
+  return iReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* unpackSize()                                                               */
+/*----------------------------------------------------------------------------*/
+uint32_t unpackSize(void)
+{
+  return g_uiSize;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* unpackClose()                                                              */
+/*----------------------------------------------------------------------------*/
+void unpackClose(void)
+{
+  for (uint8_t i = 0; i < uiLZ_PAGES; ++i)
+  {
+    if (0xFF != g_uiPage[i])
+    {
+      bufferRelease(g_uiPage[i]);
+      g_uiPage[i] = 0xFF;
+    }
+  }
+
+  g_uiChecks = 0;
+  g_uiSize   = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* resetState()                                                               */
+/*----------------------------------------------------------------------------*/
+static void resetState(void)
+{
+  memset(&g_tState, 0, sizeof(g_tState));
+  g_tState.uiRing = uiLZ_WINDOW - uiLZ_MAXLEN;
+
+  memset(g_uiWindow, ' ', sizeof(g_uiWindow));
+
+  g_uiInLen = 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* nextInput()                                                                */
+/*----------------------------------------------------------------------------*/
+static bool nextInput(fileinfo_t* pFile, uint8_t* pByte)
+{
+  bool bReturn = true;
+
+  if ((g_tState.uiIn < g_uiInPos) || (g_tState.uiIn >= (g_uiInPos + g_uiInLen)))
+  {
+    g_uiInPos = g_tState.uiIn;
+    g_uiInLen = 0;
+
+    if (UINT32_C(-1) != esx_f_seek(pFile->hFile, g_uiInPos, ESX_SEEK_SET))
+    {
+      g_uiInLen = (uint8_t) esx_f_read(pFile->hFile, g_uiInBuf, sizeof(g_uiInBuf));
+    }
+
+    bReturn = (0 < g_uiInLen) && (0xFF != g_uiInLen);
+  }
+
+  if (bReturn)
+  {
+    *pByte = g_uiInBuf[(uint8_t) (g_tState.uiIn - g_uiInPos)];
+    ++g_tState.uiIn;
+  }
+
+  return bReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* decodeByte()                                                               */
+/*----------------------------------------------------------------------------*/
+static bool decodeByte(fileinfo_t* pFile)
+{
+  bool bReturn = true;
+
+  uint8_t uiByte;
+
+  if (0 == g_tState.uiCount) /* Next token: literal or match */
+  {
+    g_tState.uiFlags >>= 1;
+
+    if (0 == (g_tState.uiFlags & 0x0100))
+    {
+      if ((bReturn = nextInput(pFile, &uiByte)))
+      {
+        g_tState.uiFlags = 0xFF00 | uiByte;
+      }
+    }
+
+    if (bReturn)
+    {
+      if (0 != (g_tState.uiFlags & 0x01))
+      {
+        bReturn = nextInput(pFile, &uiByte);
+      }
+      else
+      {
+        uint8_t uiHigh;
+
+        if ((bReturn = (nextInput(pFile, &uiByte) && nextInput(pFile, &uiHigh))))
+        {
+          g_tState.uiMatch = ((uint16_t) (uiHigh & 0xF0) << 4) | uiByte;
+          g_tState.uiCount = (uiHigh & 0x0F) + uiLZ_THRESHOLD + 1;
+        }
+      }
+    }
+  }
+
+  if (bReturn && (0 != g_tState.uiCount))
+  {
+    uiByte = g_uiWindow[g_tState.uiMatch];
+    g_tState.uiMatch = (g_tState.uiMatch + 1) & (uiLZ_WINDOW - 1);
+    --g_tState.uiCount;
+  }
+
+  if (bReturn)
+  {
+    g_uiWindow[g_tState.uiRing] = uiByte;
+    g_tState.uiRing = (g_tState.uiRing + 1) & (uiLZ_WINDOW - 1);
+    ++g_tState.uiOut;
+  }
+
+  return bReturn;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* saveCheck()                                                                */
+/*----------------------------------------------------------------------------*/
+static void saveCheck(void)
+{
+  /* All checkpoints used: keep every second one and double the distance */
+  if (uiLZ_CHECKS <= g_uiChecks)
+  {
+    for (uint8_t i = 0; i < (uiLZ_CHECKS / 2); ++i)
+    {
+      g_tCheck[i] = g_tCheck[(2 * i) + 1];
+      moveWindow((2 * i) + 1, i);
+    }
+
+    g_uiChecks = uiLZ_CHECKS / 2;
+    g_uiGap  <<= 1;
+  }
+
+  if ((0 == (g_tState.uiOut & (g_uiGap - 1))) && (0xFF != g_uiPage[g_uiChecks >> 1]))
+  {
+    g_tCheck[g_uiChecks] = g_tState;
+    copyWindow(g_uiChecks, true);
+    ++g_uiChecks;
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* restoreCheck()                                                             */
+/*----------------------------------------------------------------------------*/
+static void restoreCheck(uint32_t uiAddr)
+{
+  uint32_t uiCheck = uiAddr / g_uiGap; /* Checkpoint i is at (i + 1) * gap */
+
+  if (0 == uiCheck)
+  {
+    resetState();
+  }
+  else
+  {
+    if (uiCheck > g_uiChecks)
+    {
+      uiCheck = g_uiChecks;
+    }
+
+    if (0 < uiCheck)
+    {
+      g_tState = g_tCheck[uiCheck - 1];
+      copyWindow((uint8_t) (uiCheck - 1), false);
+    }
+    else
+    {
+      resetState();
+    }
+  }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* copyWindow()                                                               */
+/*----------------------------------------------------------------------------*/
+static void copyWindow(uint8_t uiCheck, bool bSave)
+{
+  uint8_t* pBank = bufferMapPage(g_uiPage[uiCheck >> 1]) + ((uiCheck & 0x01) ? uiLZ_WINDOW : 0);
+
+  if (bSave)
+  {
+    memcpy(pBank, g_uiWindow, uiLZ_WINDOW);
+  }
+  else
+  {
+    memcpy(g_uiWindow, pBank, uiLZ_WINDOW);
+  }
+
+  bufferUnmap();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* moveWindow()                                                               */
+/*----------------------------------------------------------------------------*/
+static void moveWindow(uint8_t uiFrom, uint8_t uiTo)
+{
+  static uint8_t uiSwap[uiLZ_SWAP];
+
+  uint16_t uiSrc = ((uiFrom & 0x01) ? uiLZ_WINDOW : 0);
+  uint16_t uiDst = ((uiTo & 0x01) ? uiLZ_WINDOW : 0);
+
+  for (uint16_t i = 0; i < uiLZ_WINDOW; i += uiLZ_SWAP)
+  {
+    memcpy(uiSwap, bufferMapPage(g_uiPage[uiFrom >> 1]) + uiSrc + i, uiLZ_SWAP);
+    memcpy(bufferMapPage(g_uiPage[uiTo >> 1]) + uiDst + i, uiSwap, uiLZ_SWAP);
+  }
+
+  bufferUnmap();
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*----------------------------------------------------------------------------*/